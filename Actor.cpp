@@ -8,6 +8,8 @@
 #include "Drawable.h"
 #include "Picture.h"
 #include <vector>
+#include <unordered_map>
+#include <cstring>
 
 /**
  * Constructor
@@ -36,6 +38,117 @@ void Actor::SetPicture(Picture* picture)
     }
 }
 
+/**
+ * Determine the absolute placement of all of the drawables.
+ *
+ * We have to determine this in tree order, which
+ * may not be the order we draw.
+ */
+void Actor::Place()
+{
+    if (mRoot == nullptr)
+        return;
+
+    auto root = Affine::Translation(mPosition.x, mPosition.y);
+    if (mCompiled)
+    {
+        PlaceRig(root);
+    }
+    else
+    {
+        mRoot->Place(root);
+    }
+}
+
+/**
+ * Set whether the drawables are placed with a compiled rig.
+ *
+ * The compiled rig is the drawable tree flattened into arrays in
+ * tree order, so placing is one loop over the arrays with no
+ * recursion. It gives the same placement as the tree. The rig is
+ * compiled from the tree when it is next placed, so set this again
+ * if drawables are added to the tree after that.
+ * @param compiled true to use the compiled rig
+ */
+void Actor::SetCompiled(bool compiled)
+{
+    mCompiled = compiled;
+    mRig.clear();
+}
+
+/**
+ * Flatten the drawable tree into the rig arrays
+ */
+void Actor::CompileRig()
+{
+    mRig.clear();
+    mRigParents.clear();
+
+    // Breadth first, so every parent comes before its children
+    mRig.push_back(mRoot.get());
+    mRigParents.push_back(-1);
+    for (int i = 0; i < (int)mRig.size(); i++)
+    {
+        for (auto const &child : mRig[i]->GetChildren())
+        {
+            mRig.push_back(child.get());
+            mRigParents.push_back(i);
+        }
+    }
+
+    int count = (int)mRig.size();
+    mRigLocal.resize(count);
+    mRigWorld.resize(count);
+    mRigMoved.resize(count);
+    for (int i = 0; i < count; i++)
+    {
+        mRigLocal[i] = mRig[i]->GetLocal();
+    }
+
+    mRigPlaced = false;
+}
+
+/**
+ * Place the drawables with the compiled rig
+ *
+ * A drawable is only placed again if it or something above it
+ * moved since the last time.
+ * @param root Transformation for the root drawable's parent
+ */
+void Actor::PlaceRig(const Affine &root)
+{
+    if (mRig.empty())
+    {
+        CompileRig();
+    }
+
+    bool rootMoved = !mRigPlaced || root != mRigRoot;
+    mRigRoot = root;
+    mRigPlaced = true;
+
+    int count = (int)mRig.size();
+    for (int i = 0; i < count; i++)
+    {
+        Drawable *drawable = mRig[i];
+        int parent = mRigParents[i];
+        bool moved = parent < 0 ? rootMoved : mRigMoved[parent] != 0;
+
+        if (drawable->IsPlaceDirty())
+        {
+            mRigLocal[i] = drawable->GetLocal();
+            moved = true;
+        }
+
+        mRigMoved[i] = moved;
+        if (moved)
+        {
+            const Affine &parentWorld = parent < 0 ? root : mRigWorld[parent];
+            mRigWorld[i] = parentWorld * mRigLocal[i];
+            drawable->SetPlaced(parentWorld, mRigWorld[i]);
+        }
+    }
+}
+
 /**
  * Draw this Actor on a device context
  * @param graphics The device context to draw on
@@ -46,11 +159,9 @@ void Actor::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     if (!mEnabled)
         return;
 
-    // This takes care of determining the absolute placement
-    // of all the child drawables. We have to determine this
-    // in tree order, which may not be the order we draw.
-    if (mRoot != nullptr)
-        mRoot->Place(mPosition, 0);
+    Place();
+    if (DrawSprite(graphics, nullptr))
+        return;
 
     // Draw
     for (auto drawable : mDrawablesInOrder)
@@ -59,6 +170,196 @@ void Actor::Draw(std::shared_ptr<wxGraphicsContext> graphics)
     }
 }
 
+/**
+ * Draw the part of this Actor inside a rectangle
+ *
+ * Drawables whose bounds are entirely outside
+ * the rectangle are not drawn.
+ * @param graphics The device context to draw on
+ * @param clip Area to draw, in picture coordinates
+ */
+void Actor::Draw(std::shared_ptr<wxGraphicsContext> graphics, const wxRect &clip)
+{
+    // Don't draw if not enabled
+    if (!mEnabled)
+        return;
+
+    Place();
+    if (DrawSprite(graphics, &clip))
+        return;
+
+    for (auto const &drawable : mDrawablesInOrder)
+    {
+        wxRect bounds;
+        if (!drawable->GetBounds(bounds) || bounds.Intersects(clip))
+        {
+            drawable->Draw(graphics);
+        }
+    }
+}
+
+/**
+ * Render this Actor
+ *
+ * This always renders every drawable, it does not use the sprite.
+ * @param renderer Renderer to draw with
+ */
+void Actor::Render(Renderer &renderer)
+{
+    if (!mEnabled)
+        return;
+
+    Place();
+    for (auto const &drawable : mDrawablesInOrder)
+    {
+        drawable->PrepareRender();
+        drawable->Render(renderer, drawable->GetPlaced());
+    }
+}
+
+/**
+ * Place a drawable and its descendants on a frame of the animation
+ * @param drawable Drawable to place
+ * @param parent Transformation from the parent to the drawing
+ * @param frame Frame to place for
+ * @param placed Map to add the transformation of each drawable to
+ */
+static void PlaceFrame(const Drawable *drawable, const Affine &parent, int frame,
+        std::unordered_map<const Drawable *, Affine> &placed)
+{
+    Affine world = parent * drawable->GetLocalAt(frame);
+    placed[drawable] = world;
+    for (auto const &child : drawable->GetChildren())
+    {
+        PlaceFrame(child.get(), world, frame, placed);
+    }
+}
+
+/**
+ * Render this Actor as it is on a frame of the animation
+ *
+ * The pose comes from the baked channels, so the
+ * timeline must be baked first.
+ * @param renderer Renderer to draw with
+ * @param frame Frame, in [0, number of frames)
+ */
+void Actor::RenderFrame(Renderer &renderer, int frame) const
+{
+    if (!mEnabled || mRoot == nullptr)
+        return;
+
+    wxPoint position = mChannel.IsValid() ? mChannel.GetBakedValue(frame) : mPosition;
+
+    std::unordered_map<const Drawable *, Affine> placed;
+    PlaceFrame(mRoot.get(), Affine::Translation(position.x, position.y), frame, placed);
+
+    for (auto const &drawable : mDrawablesInOrder)
+    {
+        auto world = placed.find(drawable.get());
+        if (world != placed.end())
+        {
+            drawable->Render(renderer, world->second);
+        }
+    }
+}
+
+/**
+ * Draw the actor from its cached sprite if the pose allows it
+ *
+ * The sprite is drawn once the pose has been the same for
+ * two draws in a row, so an actor that moves every frame
+ * never pays for drawing it. It is used until the pose
+ * version changes, which keyframes and edits both do.
+ * Must be called after Place.
+ * @param graphics The device context to draw on
+ * @param clip Area to draw, in picture coordinates, or nullptr for all of it
+ * @return true if drawn from the sprite, false if the caller must draw the drawables
+ */
+bool Actor::DrawSprite(std::shared_ptr<wxGraphicsContext> graphics, const wxRect *clip)
+{
+    if (!mSpriteCached)
+    {
+        return false;
+    }
+
+    int version = GetPoseVersion();
+    bool idle = version == mLastPoseVersion;
+    mLastPoseVersion = version;
+
+    if (version != mSpriteVersion)
+    {
+        if (!idle || !GetDrawableBounds(mSpriteBounds))
+        {
+            return false;
+        }
+
+        // Same size and pixel alignment as drawing the drawables directly
+        mSpriteBounds.Inflate(Drawable::BoundsMargin);
+        wxImage image(mSpriteBounds.GetWidth(), mSpriteBounds.GetHeight());
+        image.InitAlpha();
+        memset(image.GetAlpha(), 0, (size_t)mSpriteBounds.GetWidth() * mSpriteBounds.GetHeight());
+
+        {
+            auto sprite = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(image));
+            sprite->Translate(-mSpriteBounds.x, -mSpriteBounds.y);
+            for (auto const &drawable : mDrawablesInOrder)
+            {
+                drawable->Draw(sprite);
+            }
+        }
+
+        mSprite = graphics->CreateBitmapFromImage(image);
+        mSpriteVersion = version;
+    }
+
+    if (clip == nullptr || mSpriteBounds.Intersects(*clip))
+    {
+        graphics->DrawBitmap(mSprite, mSpriteBounds.x, mSpriteBounds.y,
+                mSpriteBounds.GetWidth(), mSpriteBounds.GetHeight());
+    }
+
+    return true;
+}
+
+/**
+ * Get a box around all of the drawables as they are placed
+ * @param bounds Set to the box, in picture coordinates
+ * @return false if there are no drawables or one has no bounds
+ */
+bool Actor::GetDrawableBounds(wxRect &bounds)
+{
+    bounds = wxRect();
+    for (auto const &drawable : mDrawablesInOrder)
+    {
+        wxRect box;
+        if (!drawable->GetBounds(box))
+        {
+            return false;
+        }
+
+        bounds = bounds.Union(box);
+    }
+
+    return !bounds.IsEmpty();
+}
+
+/**
+ * Set whether the actor is drawn from a cached sprite
+ *
+ * The sprite is a bitmap of the actor in its current pose.
+ * It saves drawing every drawable again for an actor that
+ * is not moving while others are. It costs a bitmap the
+ * size of the actor.
+ * @param cached true to use the sprite
+ */
+void Actor::SetSpriteCached(bool cached)
+{
+    mSpriteCached = cached;
+    mSprite = wxGraphicsBitmap();
+    mSpriteVersion = -1;
+    mLastPoseVersion = -1;
+}
+
 /**
  * Test to see if a mouse click is on this actor.
  * @param pos Mouse position on drawing
@@ -89,6 +390,7 @@ std::shared_ptr<Drawable> Actor::HitTest(wxPoint pos)
 void Actor::SetRoot(std::shared_ptr<Drawable> root)
 {
     mRoot = root;
+    mRig.clear();
 }
 
 /**
@@ -99,6 +401,14 @@ void Actor::AddDrawable(std::shared_ptr<Drawable> drawable)
 {
     mDrawablesInOrder.push_back(drawable);
     drawable->SetActor(this);
+    mSpriteVersion = -1;
+
+    // Already in a picture, so link it up as SetPicture would have
+    if (mPicture != nullptr)
+    {
+        drawable->SetTimeline(mPicture->GetTimeline());
+        mPicture->InvalidateIndex();
+    }
 }
 
 /**
@@ -116,14 +426,69 @@ void Actor::SetKeyframe()
 
 /**
  * Get a keyframe for an actor.
+ * @return true if the actor position or any drawable changed
  */
-void Actor::GetKeyframe()
+bool Actor::GetKeyframe()
 {
-    if (mChannel.IsValid())
+    bool changed = false;
+    if (mChannel.IsValid() && mPosition != mChannel.GetPosition())
+    {
         mPosition = mChannel.GetPosition();
+        changed = true;
+    }
 
-    for (auto drawable : mDrawablesInOrder)
+    for (auto const &drawable : mDrawablesInOrder)
+    {
+        if (drawable->GetKeyframe())
+        {
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+/**
+ * Can the animation change how this actor looks?
+ *
+ * False if no channel of the actor or its drawables has
+ * keyframes with different values, so moving through
+ * the timeline never moves anything.
+ * @return true if animated
+ */
+bool Actor::IsAnimated() const
+{
+    if (!mChannel.IsConstant())
+    {
+        return true;
+    }
+
+    for (auto const &drawable : mDrawablesInOrder)
     {
-        drawable->GetKeyframe();
+        if (!drawable->GetAngleChannel()->IsConstant())
+        {
+            return true;
+        }
     }
+
+    return false;
+}
+
+/**
+ * Get a number that changes whenever a drawable of
+ * this actor is placed somewhere new
+ *
+ * Only meaningful after Place. Equal numbers from two
+ * calls mean the actor looks the same.
+ * @return Pose version
+ */
+int Actor::GetPoseVersion() const
+{
+    int version = 0;
+    for (auto const &drawable : mDrawablesInOrder)
+    {
+        version += drawable->GetPlacedVersion();
+    }
+
+    return version;
 }
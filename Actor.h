@@ -13,7 +13,9 @@
 
 class Drawable;
 class Picture;
+class Renderer;
 #include "AnimChannelPos.h"
+#include "Affine.h"
 #include <vector>
 
 
@@ -49,6 +51,54 @@ private:
     /// The animation channel for animating the position of this Actor
     AnimChannelPos mChannel;
 
+    /// Do we place the drawables with the compiled rig?
+    bool mCompiled = false;
+
+    /// The drawables of the tree in order, every parent before its
+    /// children. Empty if the rig has not been compiled yet.
+    std::vector<Drawable *> mRig;
+
+    /// Index in mRig of the parent of each drawable, -1 for the root
+    std::vector<int> mRigParents;
+
+    /// Transformation from each drawable to its parent
+    std::vector<Affine> mRigLocal;
+
+    /// Transformation from each drawable to the drawing
+    std::vector<Affine> mRigWorld;
+
+    /// Did each drawable move the last time we placed?
+    std::vector<char> mRigMoved;
+
+    /// Transformation the root was last placed with
+    Affine mRigRoot;
+
+    /// Has the compiled rig been placed since it was compiled?
+    bool mRigPlaced = false;
+
+    /// Do we draw from a cached sprite while the pose does not change?
+    bool mSpriteCached = false;
+
+    /// The actor drawn into a bitmap, if it has been
+    wxGraphicsBitmap mSprite;
+
+    /// Where the sprite goes in the picture
+    wxRect mSpriteBounds;
+
+    /// Pose version the sprite was drawn at, -1 if there is none
+    int mSpriteVersion = -1;
+
+    /// Pose version the last time the actor was drawn
+    int mLastPoseVersion = -1;
+
+    void CompileRig();
+
+    bool DrawSprite(std::shared_ptr<wxGraphicsContext> graphics, const wxRect *clip);
+
+    bool GetDrawableBounds(wxRect &bounds);
+
+    void PlaceRig(const Affine &root);
+
 public:
     /// Default constructor (disabled)
     Actor() = delete;
@@ -69,17 +119,33 @@ public:
 
     void SetPicture(Picture* picture);
 
+    void Place();
+
     void Draw(std::shared_ptr<wxGraphicsContext> graphics);
 
+    void Draw(std::shared_ptr<wxGraphicsContext> graphics, const wxRect &clip);
+
+    void Render(Renderer &renderer);
+
+    void RenderFrame(Renderer &renderer, int frame) const;
+
     std::shared_ptr<Drawable> HitTest(wxPoint pos);
 
     void AddDrawable(std::shared_ptr<Drawable> drawable);
 
     void SetRoot(std::shared_ptr<Drawable> root);
 
+    void SetCompiled(bool compiled);
+
+    void SetSpriteCached(bool cached);
+
     void SetKeyframe();
 
-    void GetKeyframe();
+    bool GetKeyframe();
+
+    bool IsAnimated() const;
+
+    int GetPoseVersion() const;
 
 
 
@@ -125,6 +191,24 @@ public:
      */
     bool GetClickable() const { return mClickable; }
 
+    /**
+     * Get the drawables in drawing order
+     * @return Drawables
+     */
+    const std::vector<std::shared_ptr<Drawable>> &GetDrawables() const { return mDrawablesInOrder; }
+
+    /**
+     * Do we place the drawables with the compiled rig?
+     * @return true if compiled
+     */
+    bool IsCompiled() const { return mCompiled; }
+
+    /**
+     * Do we draw from a cached sprite while the pose does not change?
+     * @return true if the sprite is used
+     */
+    bool IsSpriteCached() const { return mSpriteCached; }
+
     /**
      * Get the Picture
      * @return Picture the Actor is in
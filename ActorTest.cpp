@@ -7,6 +7,7 @@
 #include "gtest/gtest.h"
 #include <Actor.h>
 #include <Picture.h>
+#include <PolyDrawable.h>
 using namespace std;
 
 TEST(ActorTest, Construct) {
@@ -152,3 +153,179 @@ TEST(ActorTest, Animation)
     ASSERT_EQ((int)(101 + 1.0 / 3.0 * (202 - 101)), actor->GetPosition().x);
     ASSERT_EQ((int)(655 + 1.0 / 3.0 * (1000 - 655)), actor->GetPosition().y);
 }
+
+/// Build an actor with a small rig of drawables, returned in tree order
+static std::vector<std::shared_ptr<PolyDrawable>> MakeRig(Actor &actor)
+{
+    std::vector<std::shared_ptr<PolyDrawable>> drawables;
+    for (int i = 0; i < 6; i++)
+    {
+        auto drawable = make_shared<PolyDrawable>(L"Part" + std::to_wstring(i));
+        drawable->SetPosition(wxPoint(10 * i, -20 * i));
+        drawable->SetRotation(0.1 * i);
+        actor.AddDrawable(drawable);
+        drawables.push_back(drawable);
+    }
+
+    // 0 is the root, 1 and 2 hang off it, 3 off 1, 4 and 5 off 3
+    actor.SetRoot(drawables[0]);
+    drawables[0]->AddChild(drawables[1]);
+    drawables[0]->AddChild(drawables[2]);
+    drawables[1]->AddChild(drawables[3]);
+    drawables[3]->AddChild(drawables[4]);
+    drawables[3]->AddChild(drawables[5]);
+    return drawables;
+}
+
+TEST(ActorTest, Compiled)
+{
+    Actor tree(L"Tree");
+    Actor compiled(L"Compiled");
+    auto treeDrawables = MakeRig(tree);
+    auto compiledDrawables = MakeRig(compiled);
+    compiled.SetCompiled(true);
+    ASSERT_TRUE(compiled.IsCompiled());
+
+    auto same = [&treeDrawables, &compiledDrawables]() {
+        for (int i = 0; i < (int)treeDrawables.size(); i++)
+        {
+            if (treeDrawables[i]->GetPlaced() != compiledDrawables[i]->GetPlaced())
+            {
+                return false;
+            }
+        }
+
+        return true;
+    };
+
+    tree.Place();
+    compiled.Place();
+    ASSERT_TRUE(same());
+
+    // Move something in the middle of the tree
+    treeDrawables[3]->SetRotation(1.2);
+    compiledDrawables[3]->SetRotation(1.2);
+    tree.Place();
+    compiled.Place();
+    ASSERT_TRUE(same());
+
+    // Move the whole actor
+    tree.SetPosition(wxPoint(300, 400));
+    compiled.SetPosition(wxPoint(300, 400));
+    tree.Place();
+    compiled.Place();
+    ASSERT_TRUE(same());
+
+    // A leaf by itself
+    treeDrawables[5]->Move(wxPoint(7, 3));
+    compiledDrawables[5]->Move(wxPoint(7, 3));
+    tree.Place();
+    compiled.Place();
+    ASSERT_TRUE(same());
+}
+
+TEST(ActorTest, IsAnimated)
+{
+    auto picture = std::make_shared<Picture>();
+    auto actor = std::make_shared<Actor>(L"Actor");
+    auto drawables = MakeRig(*actor);
+    picture->AddActor(actor);
+
+    // No keyframes
+    ASSERT_FALSE(actor->IsAnimated());
+
+    // Keyframes that hold the same pose change nothing
+    picture->SetAnimationFrame(0);
+    actor->SetKeyframe();
+    picture->SetAnimationFrame(10);
+    actor->SetKeyframe();
+    ASSERT_FALSE(actor->IsAnimated());
+
+    // A drawable keyed in another pose animates the actor
+    drawables[4]->SetRotation(1.5);
+    actor->SetKeyframe();
+    ASSERT_TRUE(actor->IsAnimated());
+}
+
+TEST(ActorTest, PoseVersion)
+{
+    Actor actor(L"Actor");
+    auto drawables = MakeRig(actor);
+
+    actor.Place();
+    int version = actor.GetPoseVersion();
+
+    // Placing again without changes keeps the version
+    actor.Place();
+    ASSERT_EQ(version, actor.GetPoseVersion());
+
+    drawables[3]->SetRotation(2);
+    actor.Place();
+    ASSERT_NE(version, actor.GetPoseVersion());
+    version = actor.GetPoseVersion();
+
+    actor.SetPosition(wxPoint(50, 60));
+    actor.Place();
+    ASSERT_NE(version, actor.GetPoseVersion());
+}
+
+/// A drawable with a box that counts how many times it is drawn
+class CountingDrawable : public Drawable
+{
+public:
+    /// Number of times drawn
+    int mDraws = 0;
+
+    CountingDrawable(const std::wstring &name) : Drawable(name) {}
+
+    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override { mDraws++; }
+
+    void Render(Renderer &renderer, const Affine &placed) const override {}
+
+    bool HitTest(wxPoint pos) override { return false; }
+
+    bool GetLocalBounds(wxRect &bounds) override
+    {
+        bounds = wxRect(0, 0, 20, 10);
+        return true;
+    }
+};
+
+TEST(ActorTest, SpriteCached)
+{
+    Actor actor(L"Actor");
+    auto drawable = std::make_shared<CountingDrawable>(L"Box");
+    actor.AddDrawable(drawable);
+    actor.SetRoot(drawable);
+    actor.SetSpriteCached(true);
+
+    wxImage image(100, 100);
+    auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(image));
+
+    // The first draw cannot know if the actor is idle
+    actor.Draw(graphics);
+    ASSERT_EQ(1, drawable->mDraws);
+
+    // Same pose again, so the sprite is drawn
+    actor.Draw(graphics);
+    ASSERT_EQ(2, drawable->mDraws);
+
+    // From now on only the sprite is drawn
+    actor.Draw(graphics);
+    actor.Draw(graphics, wxRect(0, 0, 50, 50));
+    ASSERT_EQ(2, drawable->mDraws);
+
+    // An edit throws the sprite away
+    drawable->SetRotation(0.5);
+    actor.Draw(graphics);
+    ASSERT_EQ(3, drawable->mDraws);
+
+    actor.Draw(graphics);
+    actor.Draw(graphics);
+    ASSERT_EQ(4, drawable->mDraws);
+
+    // Moving the actor does too
+    actor.SetPosition(wxPoint(10, 10));
+    actor.Draw(graphics);
+    ASSERT_EQ(5, drawable->mDraws);
+}
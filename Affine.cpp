@@ -0,0 +1,111 @@
+/**
+ * @file Affine.cpp
+ * @author Noah Wolff
+ */
+
+#include "pch.h"
+#include "Affine.h"
+
+
+/**
+ * Constructor
+ * @param a x scale and rotation
+ * @param b y shear and rotation
+ * @param c x shear and rotation
+ * @param d y scale and rotation
+ * @param tx x translation
+ * @param ty y translation
+ */
+Affine::Affine(double a, double b, double c, double d, double tx, double ty) :
+        mA(a), mB(b), mC(c), mD(d), mTx(tx), mTy(ty)
+{
+}
+
+/**
+ * Create a translation
+ * @param x Distance to move in x
+ * @param y Distance to move in y
+ * @return Translation
+ */
+Affine Affine::Translation(double x, double y)
+{
+    return Affine(1, 0, 0, 1, x, y);
+}
+
+/**
+ * Create a rotation about the origin
+ * @param angle Angle in radians, counterclockwise on the screen
+ * @return Rotation
+ */
+Affine Affine::Rotation(double angle)
+{
+    double cosA = cos(angle);
+    double sinA = sin(angle);
+    return Affine(cosA, -sinA, sinA, cosA, 0, 0);
+}
+
+/**
+ * Create a scale about the origin
+ * @param sx Scale in x
+ * @param sy Scale in y
+ * @return Scale
+ */
+Affine Affine::Scale(double sx, double sy)
+{
+    return Affine(sx, 0, 0, sy, 0, 0);
+}
+
+/**
+ * Compose two transformations
+ * @param other Transformation applied first
+ * @return Transformation that applies other, then this
+ */
+Affine Affine::operator*(const Affine &other) const
+{
+    return Affine(mA * other.mA + mC * other.mB,
+            mB * other.mA + mD * other.mB,
+            mA * other.mC + mC * other.mD,
+            mB * other.mC + mD * other.mD,
+            mA * other.mTx + mC * other.mTy + mTx,
+            mB * other.mTx + mD * other.mTy + mTy);
+}
+
+/**
+ * Get the inverse transformation
+ *
+ * The transformation must not collapse the plane
+ * (no zero scale).
+ * @return Transformation that undoes this one
+ */
+Affine Affine::Inverse() const
+{
+    double det = mA * mD - mB * mC;
+    double a = mD / det;
+    double b = -mB / det;
+    double c = -mC / det;
+    double d = mA / det;
+    return Affine(a, b, c, d, -(a * mTx + c * mTy), -(b * mTx + d * mTy));
+}
+
+/**
+ * Transform a point
+ * @param point Point to transform
+ * @return Transformed point
+ */
+wxPoint2DDouble Affine::Apply(const wxPoint2DDouble &point) const
+{
+    return wxPoint2DDouble(mA * point.m_x + mC * point.m_y + mTx,
+            mB * point.m_x + mD * point.m_y + mTy);
+}
+
+/**
+ * Transform a vector, a difference between two points,
+ * so the translation does not apply
+ * @param vector Vector to transform
+ * @return Transformed vector
+ */
+wxPoint2DDouble Affine::ApplyVector(const wxPoint2DDouble &vector) const
+{
+    return wxPoint2DDouble(mA * vector.m_x + mC * vector.m_y,
+            mB * vector.m_x + mD * vector.m_y);
+}
@@ -0,0 +1,124 @@
+/**
+ * @file Affine.h
+ * @author Noah Wolff
+ *
+ * A 2D affine transformation.
+ */
+
+#ifndef CANADIANEXPERIENCE_AFFINE_H
+#define CANADIANEXPERIENCE_AFFINE_H
+
+
+/**
+ * A 2D affine transformation.
+ *
+ * This is the 2x3 matrix
+ *
+ *     | a  c  tx |
+ *     | b  d  ty |
+ *
+ * mapping (x, y) to (a*x + c*y + tx, b*x + d*y + ty), the same
+ * layout wxGraphicsMatrix uses. Everything is in doubles, so
+ * points keep their sub-pixel positions until they are drawn.
+ *
+ * Rotations use the same sense as the rest of the program: a
+ * positive angle turns counterclockwise on the screen.
+ */
+class Affine {
+private:
+    /// x scale and rotation
+    double mA = 1;
+
+    /// y shear and rotation
+    double mB = 0;
+
+    /// x shear and rotation
+    double mC = 0;
+
+    /// y scale and rotation
+    double mD = 1;
+
+    /// x translation
+    double mTx = 0;
+
+    /// y translation
+    double mTy = 0;
+
+public:
+    /// Constructor, the identity transformation
+    Affine() {}
+
+    Affine(double a, double b, double c, double d, double tx, double ty);
+
+    static Affine Translation(double x, double y);
+
+    static Affine Rotation(double angle);
+
+    static Affine Scale(double sx, double sy);
+
+    Affine operator*(const Affine &other) const;
+
+    Affine Inverse() const;
+
+    wxPoint2DDouble Apply(const wxPoint2DDouble &point) const;
+
+    wxPoint2DDouble ApplyVector(const wxPoint2DDouble &vector) const;
+
+    /**
+     * Transform a point
+     * @param point Point to transform
+     * @return Transformed point, not rounded
+     */
+    wxPoint2DDouble Apply(const wxPoint &point) const { return Apply(wxPoint2DDouble(point.x, point.y)); }
+
+    /**
+     * Are two transformations exactly the same?
+     * @param other Transformation to compare to
+     * @return true if equal
+     */
+    bool operator==(const Affine &other) const
+    {
+        return mA == other.mA && mB == other.mB && mC == other.mC && mD == other.mD &&
+                mTx == other.mTx && mTy == other.mTy;
+    }
+
+    /**
+     * Are two transformations different?
+     * @param other Transformation to compare to
+     * @return true if not equal
+     */
+    bool operator!=(const Affine &other) const { return !(*this == other); }
+
+    /**
+     * Get the a matrix element
+     * @return x scale and rotation
+     */
+    double GetA() const { return mA; }
+
+    /**
+     * Get the b matrix element
+     * @return y shear and rotation
+     */
+    double GetB() const { return mB; }
+
+    /**
+     * Get the c matrix element
+     * @return x shear and rotation
+     */
+    double GetC() const { return mC; }
+
+    /**
+     * Get the d matrix element
+     * @return y scale and rotation
+     */
+    double GetD() const { return mD; }
+
+    /**
+     * Get the translation
+     * @return Where the transformation puts the origin
+     */
+    wxPoint2DDouble GetTranslation() const { return wxPoint2DDouble(mTx, mTy); }
+
+};
+
+#endif //CANADIANEXPERIENCE_AFFINE_H
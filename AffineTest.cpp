@@ -0,0 +1,44 @@
+/**
+ * @file AffineTest.cpp
+ * @author Noah Wolff
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <Affine.h>
+
+TEST(AffineTest, Identity)
+{
+    Affine affine;
+    auto p = affine.Apply(wxPoint(3, -4));
+    ASSERT_EQ(3, p.m_x);
+    ASSERT_EQ(-4, p.m_y);
+}
+
+TEST(AffineTest, Rotation)
+{
+    // A positive angle turns counterclockwise on the screen,
+    // where y is down, so right turns to up
+    auto p = Affine::Rotation(M_PI / 2).Apply(wxPoint(10, 0));
+    ASSERT_NEAR(0, p.m_x, 0.00001);
+    ASSERT_NEAR(-10, p.m_y, 0.00001);
+}
+
+TEST(AffineTest, Compose)
+{
+    // Rotate first, then scale, then move
+    auto affine = Affine::Translation(100, 200) * Affine::Scale(2, 3) * Affine::Rotation(M_PI / 2);
+    auto p = affine.Apply(wxPoint(10, 0));
+    ASSERT_NEAR(100, p.m_x, 0.00001);
+    ASSERT_NEAR(170, p.m_y, 0.00001);
+
+    // Vectors are not moved
+    auto v = affine.ApplyVector(wxPoint2DDouble(10, 0));
+    ASSERT_NEAR(0, v.m_x, 0.00001);
+    ASSERT_NEAR(-30, v.m_y, 0.00001);
+
+    // The inverse takes us back
+    auto q = affine.Inverse().Apply(p);
+    ASSERT_NEAR(10, q.m_x, 0.00001);
+    ASSERT_NEAR(0, q.m_y, 0.00001);
+}
@@ -6,17 +6,29 @@
 #include "pch.h"
 #include "AnimChannel.h"
 #include "Timeline.h"
+#include <algorithm>
+#include <cmath>
 
+/// Number of keyframes Seek will step over one at a time
+/// before it switches to a binary search of the keyframes
+const int MaxIncrementalSteps = 4;
 
 /**
- * Determine how we should insert a keyframe into our keyframe list.
- * @param keyframe The keyframe to insert
+ * Insert a keyframe frame number for the current frame.
+ *
+ * The derived channel stores the keyframe value at the returned
+ * index. If the channel already had a keyframe on this frame, the
+ * number of keyframes is unchanged and the value should replace the
+ * existing one.
+ * @return Index of the keyframe for the current frame
  */
-void AnimChannel::InsertKeyframe(std::shared_ptr<Keyframe> keyframe)
+int AnimChannel::InsertFrame()
 {
-    // Get the current frame and tell it to the keyframe we are setting.
+    // Get the current frame and make sure the keyframe
+    // indices are for it. They may not be if the channel
+    // was last set from baked values.
     int currFrame = mTimeline->GetCurrentFrame();
-    keyframe->SetFrame(currFrame);
+    Seek(currFrame);
 
     // The possible options for keyframe insertion
     enum { Append, Replace, Insert } action;
@@ -33,7 +45,7 @@ void AnimChannel::InsertKeyframe(std::shared_ptr<Keyframe> keyframe)
     {
         // We know mKeyframe1 is valid
         // So, we are after it.
-        int frame1 = mKeyframes[mKeyframe1]->GetFrame();
+        int frame1 = mFrames[mKeyframe1];
 
         if (mKeyframe2 < 0)
         {
@@ -58,23 +70,262 @@ void AnimChannel::InsertKeyframe(std::shared_ptr<Keyframe> keyframe)
     {
     case Append:
         // Add to end and the keyframe to the left becomes the new keyframe
-        mKeyframes.push_back(keyframe);
-        mKeyframe1 = (int)mKeyframes.size() - 1;
+        mFrames.push_back(currFrame);
+        mKeyframe1 = (int)mFrames.size() - 1;
         break;
 
     case Replace:
         // Replace the current keyframe
-        mKeyframes[mKeyframe1] = keyframe;
         break;
 
     case Insert:
         // Insert after mKeyframe1
         // and mKeyframe1 becomes this new insertion (frame we are on)
-        mKeyframes.insert(mKeyframes.begin() + (mKeyframe1 + 1), keyframe);
+        mFrames.insert(mFrames.begin() + (mKeyframe1 + 1), currFrame);
         mKeyframe1++;
+        mKeyframe2 = mKeyframe1 + 1;
         break;
     }
 
+    return mKeyframe1;
+}
+
+/**
+ * Insert a keyframe frame number for any frame.
+ *
+ * This does not depend on the current frame. The derived channel
+ * stores the keyframe value at the returned index, replacing the
+ * existing value if there already was a keyframe on the frame.
+ * @param frame Frame for the keyframe
+ * @return Index of the keyframe for the frame
+ */
+int AnimChannel::InsertFrame(int frame)
+{
+    auto loc = std::lower_bound(mFrames.begin(), mFrames.end(), frame);
+    int index = (int)(loc - mFrames.begin());
+    if (loc == mFrames.end() || *loc != frame)
+    {
+        mFrames.insert(loc, frame);
+
+        // The indices are found again on the next Seek
+        mKeyframe1 = -1;
+        mKeyframe2 = -1;
+    }
+
+    return index;
+}
+
+/**
+ * Merge a sorted set of new keyframe frame numbers into the keyframes.
+ *
+ * One pass over both. Where a new frame matches an existing keyframe,
+ * the new keyframe replaces it. If a frame is in the new frames more
+ * than once, the last one wins.
+ * @param frames New frame numbers, in nondecreasing order
+ * @param source Filled with, for each resulting keyframe, the index of
+ * the old keyframe it keeps (>= 0) or -1 - k for new frame k
+ */
+void AnimChannel::MergeFrames(const std::vector<int> &frames, std::vector<int> &source)
+{
+    std::vector<int> merged;
+    merged.reserve(mFrames.size() + frames.size());
+    source.clear();
+    source.reserve(mFrames.size() + frames.size());
+
+    int old = 0;
+    int count = (int)mFrames.size();
+    for (int k = 0; k < (int)frames.size(); k++)
+    {
+        // Skip to the last of a run of the same new frame
+        if (k + 1 < (int)frames.size() && frames[k + 1] == frames[k])
+        {
+            continue;
+        }
+
+        while (old < count && mFrames[old] < frames[k])
+        {
+            merged.push_back(mFrames[old]);
+            source.push_back(old++);
+        }
+
+        if (old < count && mFrames[old] == frames[k])
+        {
+            // Replaced
+            old++;
+        }
+
+        merged.push_back(frames[k]);
+        source.push_back(-1 - k);
+    }
+
+    for ( ; old < count; old++)
+    {
+        merged.push_back(mFrames[old]);
+        source.push_back(old);
+    }
+
+    mFrames.swap(merged);
+    mKeyframe1 = -1;
+    mKeyframe2 = -1;
+}
+
+/**
+ * Delete all keyframes in a range of frames
+ * @param first First frame of the range
+ * @param last Last frame of the range, inclusive
+ */
+void AnimChannel::DeleteKeyframes(int first, int last)
+{
+    std::vector<int> frames;
+    std::vector<int> source;
+    for (int i = 0; i < (int)mFrames.size(); i++)
+    {
+        if (mFrames[i] < first || mFrames[i] > last)
+        {
+            frames.push_back(mFrames[i]);
+            source.push_back(i);
+        }
+    }
+
+    if (frames.size() != mFrames.size())
+    {
+        Remap(frames, source);
+    }
+}
+
+/**
+ * Move all keyframes in a range of frames by a number of frames.
+ *
+ * A moved keyframe replaces any keyframe already on the frame it lands on.
+ * @param first First frame of the range
+ * @param last Last frame of the range, inclusive
+ * @param offset Number of frames to move by, negative to move earlier
+ */
+void AnimChannel::ShiftKeyframes(int first, int last, int offset)
+{
+    Retime(first, last, 1, offset);
+}
+
+/**
+ * Stretch or squeeze the keyframes in a range of frames.
+ *
+ * The first frame of the range stays put and the others move so
+ * their distance from it is multiplied by the scale, rounded to
+ * a frame. A moved keyframe replaces any keyframe already on the
+ * frame it lands on.
+ * @param first First frame of the range
+ * @param last Last frame of the range, inclusive
+ * @param scale Scale factor, greater than zero
+ */
+void AnimChannel::ScaleKeyframes(int first, int last, double scale)
+{
+    if (scale > 0)
+    {
+        Retime(first, last, scale, 0);
+    }
+}
+
+/**
+ * Set how the value leaves each keyframe in a range of frames.
+ * @param first First frame of the range
+ * @param last Last frame of the range, inclusive
+ * @param interpolation Interpolation to the next keyframe
+ */
+void AnimChannel::SetInterpolation(int first, int last, Interpolation interpolation)
+{
+    int begin = (int)(std::lower_bound(mFrames.begin(), mFrames.end(), first) - mFrames.begin());
+    int end = (int)(std::upper_bound(mFrames.begin(), mFrames.end(), last) - mFrames.begin());
+    if (begin < end)
+    {
+        SetInterpolations(begin, end, interpolation);
+    }
+}
+
+/**
+ * Move the keyframes in a range of frames.
+ *
+ * A keyframe on frame f in [first, last] moves to
+ * first + round((f - first) * scale) + offset. This is one pass
+ * merging the moved keyframes with the ones outside the range.
+ * @param first First frame of the range
+ * @param last Last frame of the range, inclusive
+ * @param scale Scale factor, greater than zero
+ * @param offset Number of frames to move by after scaling
+ */
+void AnimChannel::Retime(int first, int last, double scale, int offset)
+{
+    int begin = (int)(std::lower_bound(mFrames.begin(), mFrames.end(), first) - mFrames.begin());
+    int end = (int)(std::upper_bound(mFrames.begin(), mFrames.end(), last) - mFrames.begin());
+    if (begin >= end)
+    {
+        return;
+    }
+
+    // The moved keyframes stay in order. If two land on
+    // the same frame, the later one wins.
+    std::vector<int> movedFrames;
+    std::vector<int> movedSource;
+    for (int i = begin; i < end; i++)
+    {
+        int frame = first + (int)std::lround((mFrames[i] - first) * scale) + offset;
+        if (!movedFrames.empty() && movedFrames.back() == frame)
+        {
+            movedSource.back() = i;
+        }
+        else
+        {
+            movedFrames.push_back(frame);
+            movedSource.push_back(i);
+        }
+    }
+
+    // Merge with the keyframes outside the range
+    int numMoved = (int)movedFrames.size();
+    int numOutside = (int)mFrames.size() - (end - begin);
+    auto outside = [begin, end](int k) { return k < begin ? k : k + (end - begin); };
+
+    std::vector<int> frames;
+    std::vector<int> source;
+    int o = 0;
+    int m = 0;
+    while (o < numOutside || m < numMoved)
+    {
+        if (m == numMoved || (o < numOutside && mFrames[outside(o)] < movedFrames[m]))
+        {
+            frames.push_back(mFrames[outside(o)]);
+            source.push_back(outside(o));
+            o++;
+        }
+        else if (o < numOutside && mFrames[outside(o)] == movedFrames[m])
+        {
+            // Replaced by the moved keyframe
+            o++;
+        }
+        else
+        {
+            frames.push_back(movedFrames[m]);
+            source.push_back(movedSource[m]);
+            m++;
+        }
+    }
+
+    Remap(frames, source);
+}
+
+/**
+ * Replace the keyframes with a rearranged set
+ * @param frames New keyframe frame numbers. Emptied by this call.
+ * @param source For each new keyframe, the index of the old keyframe it came from
+ */
+void AnimChannel::Remap(std::vector<int> &frames, const std::vector<int> &source)
+{
+    mFrames.swap(frames);
+    frames.clear();
+    RemapValues(source);
+
+    // The indices are found again on the next Seek
+    mKeyframe1 = -1;
+    mKeyframe2 = -1;
 }
 
 /**
@@ -88,66 +339,115 @@ void AnimChannel::InsertKeyframe(std::shared_ptr<Keyframe> keyframe)
  * indices.
  * @param currFrame The frame we are on.
  */
-void AnimChannel::SetFrame(int currFrame)
+void AnimChannel::Seek(int currFrame)
 {
+    // Large jumps (scrubbing, seeking) go straight to the right keyframes
+    if (IsFarFrom(currFrame))
+    {
+        SeekFrame(currFrame);
+    }
+
     // Should we move forward in time?
-    while (mKeyframe2 >= 0 && mKeyframes[mKeyframe2]->GetFrame() <= currFrame)
+    while (mKeyframe2 >= 0 && mFrames[mKeyframe2] <= currFrame)
     {
         mKeyframe1 = mKeyframe2;
         mKeyframe2++;
-        if (mKeyframe2 >= (int)mKeyframes.size())
+        if (mKeyframe2 >= (int)mFrames.size())
             mKeyframe2 = -1;
     }
 
     // Should we move backwards in time?
-    while (mKeyframe1 >= 0 && mKeyframes[mKeyframe1]->GetFrame() > currFrame)
+    while (mKeyframe1 >= 0 && mFrames[mKeyframe1] > currFrame)
     {
         mKeyframe2 = mKeyframe1;
         mKeyframe1--;
     }
+}
 
-    //
-    // There are four possibilities here:
-    // a) No keyframes  (mKeyframe1 < 0 and mKeyframe2 < 0)
-    // b) Only a keyframe to the left (mKeyframe1 >= 0 and mKeyframe2 < 0)
-    // c) Between two keyframes (mKeyframe1 >= 0 and mKeyframe2 >= 0)
-    // d) Only a keyframe to the right (mKeyframe1 < 0 and mKeyframe2 >= 0)
-    //
-    if (mKeyframe1 >= 0 && mKeyframe2 >= 0)
-    {
-        // c) Between two keyframes
-        // So we have to tween
-        mKeyframes[mKeyframe1]->UseAs1();
-        mKeyframes[mKeyframe2]->UseAs2();
+/**
+ * Compute the t value for tweening between two keyframes.
+ *
+ * This works from integer frame numbers, so it does not depend
+ * on the frame rate and gives the same t for the same frame
+ * however the frame was reached.
+ * @param keyframe1 Index of the keyframe at t=0
+ * @param keyframe2 Index of the keyframe at t=1
+ * @param frame The frame
+ * @param subframe Fraction of the way from frame to the next frame, in [0, 1)
+ * @return t value. t=0 means keyframe1, t=1 means keyframe2.
+ */
+double AnimChannel::GetTweenT(int keyframe1, int keyframe2, int frame, double subframe) const
+{
+    int frame1 = mFrames[keyframe1];
+    return (frame - frame1 + subframe) / (mFrames[keyframe2] - frame1);
+}
 
-        // Compute the t value
-        double frameRate = GetTimeline()->GetFrameRate();
-        double time1 = mKeyframes[mKeyframe1]->GetFrame() / frameRate;
-        double time2 = mKeyframes[mKeyframe2]->GetFrame() / frameRate;
-        double t = (GetTimeline()->GetCurrentTime() - time1) / (time2 - time1);
+/**
+ * Get the number of frames in the timeline
+ * @return Number of frames
+ */
+int AnimChannel::GetNumFrames() const
+{
+    return mTimeline->GetNumFrames();
+}
 
-        // And tween
-        Tween(t);
+/**
+ * Is a frame more than a few keyframes away from the current keyframes?
+ *
+ * This only looks MaxIncrementalSteps keyframes ahead of or behind the
+ * current keyframes, so it is constant time.
+ * @param currFrame The frame we are moving to
+ * @return true if the incremental walk in Seek would be long
+ */
+bool AnimChannel::IsFarFrom(int currFrame) const
+{
+    int count = (int)mFrames.size();
+    if (count == 0)
+    {
+        return false;
     }
-    else if (mKeyframe1 >= 0)
+
+    if (mKeyframe1 < 0 && mKeyframe2 < 0)
     {
-        // b) Only a keyframe to the left
-        // We are only using keyframe 1
-        mKeyframes[mKeyframe1]->UseOnly();
+        // We have keyframes, but no idea where we are
+        return true;
     }
-    else if (mKeyframe2 >= 0)
+
+    // Forward: the keyframe MaxIncrementalSteps past keyframe 2 is at or before us
+    int ahead = mKeyframe2 + MaxIncrementalSteps;
+    if (mKeyframe2 >= 0 && ahead < count && mFrames[ahead] <= currFrame)
     {
-        // d) Only a keyframe to the right
-        // We are only using keyframe 2
-        mKeyframes[mKeyframe2]->UseOnly();
+        return true;
     }
+
+    // Backward: the keyframe MaxIncrementalSteps before keyframe 1 is after us
+    int behind = mKeyframe1 - MaxIncrementalSteps;
+    return mKeyframe1 >= 0 && behind >= 0 && mFrames[behind] > currFrame;
+}
+
+/**
+ * Position the keyframe indices for a frame using a binary search.
+ *
+ * On return mKeyframe1 is the last keyframe at or before the frame
+ * and mKeyframe2 is the first keyframe after it, with -1 for either
+ * if there is no such keyframe.
+ * @param currFrame The frame to seek to
+ */
+void AnimChannel::SeekFrame(int currFrame)
+{
+    // First keyframe that is after the current frame
+    auto next = std::upper_bound(mFrames.begin(), mFrames.end(), currFrame);
+
+    int index = (int)(next - mFrames.begin());
+    mKeyframe1 = index - 1;
+    mKeyframe2 = index < (int)mFrames.size() ? index : -1;
 }
 
 /**
   * Is the channel valid, meaning has keyframes?
   * @return true if the channel is valid.
   */
-bool AnimChannel::IsValid()
+bool AnimChannel::IsValid() const
 {
-    return mKeyframe1 >= 0 || mKeyframe2 >= 0;
+    return !mFrames.empty();
 }
@@ -8,6 +8,8 @@
 #ifndef CANADIANEXPERIENCE_ANIMCHANNEL_H
 #define CANADIANEXPERIENCE_ANIMCHANNEL_H
 
+#include <vector>
+
 class Timeline;
 
 
@@ -15,81 +17,68 @@ class Timeline;
  * Base class for animation channels
  *
  * This class provides basic functionality and a polymorphic
- * representation for animation channels.
+ * representation for animation channels. It owns the sorted
+ * keyframe frame numbers and the keyframe indices for the current
+ * frame. The keyframe values are stored by the derived AnimChannelT
+ * in an array parallel to the frame numbers.
  */
 class AnimChannel {
+public:
+    /**
+     * How the value moves from a keyframe to the next one
+     */
+    enum class Interpolation {
+        Linear,     ///< Straight line to the next keyframe
+        Step,       ///< Hold the value until the next keyframe
+        CatmullRom, ///< Smooth curve through the neighbouring keyframes
+        Ease        ///< Bezier ease out of this keyframe and into the next
+    };
+
 protected:
     /// Default constructor
     AnimChannel() { }
 
+    int InsertFrame();
 
-    //
-    // Keyframe
-    //
-
-    /// Class that represents a keyframe
-    class Keyframe {
-    private:
-        /// Frame number
-        int mFrame;
-
-        /// Channel for the Frame
-        AnimChannel* mChannel;
-
-    protected:
-        /**
-         * Constructor
-         * @param channel Channel we are associated with
-         */
-        Keyframe(AnimChannel *channel) : mChannel(channel) {}
-
-
-    public:
-        /// Default constructor (disabled)
-        Keyframe() = delete;
-
-        /// Copy constructor (disabled)
-        Keyframe(const Keyframe &) = delete;
+    int InsertFrame(int frame);
 
-        /// Assignment operator
-        void operator=(const Keyframe &) = delete;
-
-
-        /// Virtual for use in derived Keyframe classes
-        virtual void UseAs1() = 0;
-
-        /// Virtual for use in derived Keyframe classes
-        virtual void UseAs2() = 0;
-
-        /// Virtual for use in derived Keyframe classes
-        virtual void UseOnly() = 0;
+    void MergeFrames(const std::vector<int> &frames, std::vector<int> &source);
 
+    /**
+     * Rearrange the keyframe values after the keyframe frame
+     * numbers have been rearranged
+     * @param source For each new keyframe, the index of the
+     * old keyframe whose value it takes
+     */
+    virtual void RemapValues(const std::vector<int> &source) = 0;
 
+    /**
+     * Set the interpolation of a range of keyframes
+     * @param begin First keyframe index
+     * @param end One past the last keyframe index
+     * @param interpolation How to leave each of the keyframes
+     */
+    virtual void SetInterpolations(int begin, int end, Interpolation interpolation) = 0;
 
-        /**
-         * Get the frame number
-         * @return Frame number
-         */
-        int GetFrame() const { return mFrame; }
+    void Seek(int currFrame);
 
-        /**
-         * Set the frame number
-         * @param frame Frame number value to set
-         */
-        void SetFrame(int frame) { mFrame = frame; }
+    double GetTweenT(int keyframe1, int keyframe2, int frame, double subframe) const;
 
-    };
+    int GetNumFrames() const;
 
-    void InsertKeyframe(std::shared_ptr<Keyframe> keyFrame);
+    /**
+     * Get the index of keyframe 1, the last keyframe at or
+     * before the current frame
+     * @return Keyframe index or -1 if none
+     */
+    int GetKeyframe1() const { return mKeyframe1; }
 
     /**
-     * Compute a position that is an interpolation
-     * between two keyframes
-     *
-     * @param t A t value. t=0 means keyframe1, t=1 means keyframe2.
-     * Other values interpolate between.
+     * Get the index of keyframe 2, the first keyframe after
+     * the current frame
+     * @return Keyframe index or -1 if none
      */
-    virtual void Tween(double t) = 0;
+    int GetKeyframe2() const { return mKeyframe2; }
 
 private:
     /// Name of the channel
@@ -104,8 +93,16 @@ private:
     /// Keyframe 2 value
     int mKeyframe2 = -1;
 
-    /// The collection of keyframes for this channel
-    std::vector<std::shared_ptr<Keyframe>> mKeyframes;
+    /// The frame numbers of the keyframes for this channel, in order
+    std::vector<int> mFrames;
+
+    bool IsFarFrom(int currFrame) const;
+
+    void SeekFrame(int currFrame);
+
+    void Retime(int first, int last, double scale, int offset);
+
+    void Remap(std::vector<int> &frames, const std::vector<int> &source);
 
 public:
     /// Copy constructor (disabled)
@@ -119,9 +116,38 @@ public:
 
 
 
-    bool IsValid();
+    bool IsValid() const;
+
+    void DeleteKeyframes(int first, int last);
+
+    void ShiftKeyframes(int first, int last, int offset);
 
-    void SetFrame(int currFrame);
+    void ScaleKeyframes(int first, int last, double scale);
+
+    void SetInterpolation(int first, int last, Interpolation interpolation);
+
+    /**
+     * Set the channel value for a frame
+     * @param currFrame The frame we are on
+     * @param subframe Fraction of the way to the next frame, in [0, 1)
+     */
+    virtual void SetFrame(int currFrame, double subframe = 0) = 0;
+
+    /**
+     * Set the channel value for a frame from the baked values,
+     * baking the channel first if needed
+     * @param currFrame The frame we are on, in [0, number of frames)
+     */
+    virtual void SetBakedFrame(int currFrame) = 0;
+
+    /// Evaluate the channel for every frame of the timeline
+    virtual void Bake() = 0;
+
+    /**
+     * Are the baked values up to date?
+     * @return true if baked
+     */
+    virtual bool IsBaked() const = 0;
 
 
 
@@ -148,6 +174,19 @@ public:
      * @param timeline Timeline to set
      */
     void SetTimeline(Timeline* timeline) { mTimeline = timeline; }
+
+    /**
+     * Get the number of keyframes in the channel
+     * @return Number of keyframes
+     */
+    int GetNumKeyframes() const { return (int)mFrames.size(); }
+
+    /**
+     * Get the frame number of a keyframe
+     * @param keyframe Keyframe index
+     * @return Frame number
+     */
+    int GetKeyframeFrame(int keyframe) const { return mFrames[keyframe]; }
 };
 
 #endif //CANADIANEXPERIENCE_ANIMCHANNEL_H
@@ -6,6 +6,7 @@
 #include <pch.h>
 #include "gtest/gtest.h"
 #include <AnimChannelAngle.h>
+#include <Timeline.h>
 using namespace std;
 
 TEST(AnimChannelAngleTest, Construct) {
@@ -22,3 +23,179 @@ TEST(AnimChannelAngleTest, NameGetterSetter) {
     // Test for new name
     ASSERT_EQ(acl.GetName(), L"Jimbo");
 }
+
+TEST(AnimChannelAngleTest, Seek)
+{
+    Timeline timeline;
+    timeline.SetNumFrames(10000);
+
+    AnimChannelAngle channel;
+    timeline.AddChannel(&channel);
+
+    // A keyframe every 10 frames, angle equal to the frame number
+    for (int frame = 0; frame <= 9000; frame += 10)
+    {
+        timeline.SetCurrentTime((frame + 0.5) / 30.0);
+        channel.SetKeyframe(frame);
+    }
+
+    // Jump around in big steps in both directions
+    for (int frame : {0, 9000, 15, 8995, 4001, 4002, 4013, 25, 9500})
+    {
+        timeline.SetCurrentTime(frame / 30.0);
+        ASSERT_NEAR(std::min(frame, 9000), channel.GetAngle(), 0.001);
+    }
+}
+
+TEST(AnimChannelAngleTest, Keyframes)
+{
+    Timeline timeline;
+    AnimChannelAngle channel;
+    timeline.AddChannel(&channel);
+
+    // Keyframes set out of order end up sorted by frame
+    for (int frame : {30, 10, 20, 20})
+    {
+        timeline.SetCurrentTime((frame + 0.5) / 30.0);
+        channel.SetKeyframe(frame * 2);
+    }
+
+    ASSERT_EQ(3, channel.GetNumKeyframes());
+    ASSERT_EQ(10, channel.GetKeyframeFrame(0));
+    ASSERT_EQ(20, channel.GetKeyframeFrame(1));
+    ASSERT_EQ(30, channel.GetKeyframeFrame(2));
+    ASSERT_NEAR(20, channel.GetKeyframeValue(0), 0.00001);
+    ASSERT_NEAR(40, channel.GetKeyframeValue(1), 0.00001);
+    ASSERT_NEAR(60, channel.GetKeyframeValue(2), 0.00001);
+
+    timeline.SetCurrentTime(15 / 30.0);
+    ASSERT_NEAR(30, channel.GetAngle(), 0.00001);
+}
+
+TEST(AnimChannelAngleTest, Changed)
+{
+    Timeline timeline;
+    AnimChannelAngle channel;
+    timeline.AddChannel(&channel);
+
+    timeline.SetCurrentTime(1.0);
+    channel.SetKeyframe(1.0);
+    timeline.SetCurrentTime(2.0);
+    channel.SetKeyframe(2.0);
+
+    // Between the keyframes the value changes every frame
+    timeline.SetCurrentTime(1.5);
+    ASSERT_TRUE(channel.IsChanged());
+    timeline.SetCurrentTime(1.6);
+    ASSERT_TRUE(channel.IsChanged());
+
+    // The same time again changes nothing
+    timeline.SetCurrentTime(1.6);
+    ASSERT_FALSE(channel.IsChanged());
+
+    // Holding on the last keyframe only changes the first time
+    timeline.SetCurrentTime(3.0);
+    ASSERT_TRUE(channel.IsChanged());
+    timeline.SetCurrentTime(4.0);
+    ASSERT_FALSE(channel.IsChanged());
+    ASSERT_NEAR(2.0, channel.GetAngle(), 0.00001);
+
+    // Editing the keyframe we are holding on is seen
+    channel.SetKeyframe(5.0);
+    timeline.SetCurrentTime(4.0);
+    ASSERT_TRUE(channel.IsChanged());
+    ASSERT_NEAR(5.0, channel.GetAngle(), 0.00001);
+}
+
+/**
+ * Get the keyframe frames of a channel
+ * @param channel Channel to get the frames from
+ * @return Vector of frame numbers
+ */
+static std::vector<int> Frames(const AnimChannelAngle &channel)
+{
+    std::vector<int> frames;
+    for (int k = 0; k < channel.GetNumKeyframes(); k++)
+    {
+        frames.push_back(channel.GetKeyframeFrame(k));
+    }
+
+    return frames;
+}
+
+TEST(AnimChannelAngleTest, BulkEdit)
+{
+    Timeline timeline;
+    AnimChannelAngle channel;
+    timeline.AddChannel(&channel);
+
+    // Keyframes anywhere, without moving the current time
+    channel.SetKeyframes({{40, 4}, {10, 1}, {30, 3}, {20, 2}, {50, 5}});
+    channel.SetKeyframe(0, 0.0);
+    ASSERT_EQ(std::vector<int>({0, 10, 20, 30, 40, 50}), Frames(channel));
+
+    // Delete a range
+    channel.DeleteKeyframes(15, 35);
+    ASSERT_EQ(std::vector<int>({0, 10, 40, 50}), Frames(channel));
+
+    // Shift a range onto an existing keyframe, which it replaces
+    channel.ShiftKeyframes(40, 50, 10);
+    ASSERT_EQ(std::vector<int>({0, 10, 50, 60}), Frames(channel));
+    ASSERT_NEAR(4, channel.GetKeyframeValue(2), 0.00001);
+    ASSERT_NEAR(5, channel.GetKeyframeValue(3), 0.00001);
+
+    // Double the timing of everything
+    channel.ScaleKeyframes(0, 100, 2.0);
+    ASSERT_EQ(std::vector<int>({0, 20, 100, 120}), Frames(channel));
+
+    // The current time still works after the edits
+    timeline.SetCurrentTime(110 / 30.0);
+    ASSERT_NEAR(4.5, channel.GetAngle(), 0.00001);
+    timeline.SetCurrentTime(10 / 30.0);
+    ASSERT_NEAR(0.5, channel.GetAngle(), 0.00001);
+}
+
+TEST(AnimChannelAngleTest, Interpolation)
+{
+    Timeline timeline;
+    AnimChannelAngle channel;
+    timeline.AddChannel(&channel);
+
+    channel.SetKeyframes({{0, 0.0}, {10, 1.0}, {20, 3.0}, {30, 3.0}});
+    ASSERT_EQ(AnimChannel::Interpolation::Linear, channel.GetKeyframeInterpolation(0));
+
+    auto angle = [&timeline, &channel](int frame, double subframe) {
+        timeline.EvaluateFrame(frame, subframe);
+        return channel.GetAngle();
+    };
+
+    ASSERT_DOUBLE_EQ(0.5, angle(5, 0));
+
+    // Step holds until the next keyframe
+    channel.SetInterpolation(0, 0, AnimChannel::Interpolation::Step);
+    ASSERT_EQ(AnimChannel::Interpolation::Step, channel.GetKeyframeInterpolation(0));
+    ASSERT_DOUBLE_EQ(0, angle(9, 0.9));
+    ASSERT_DOUBLE_EQ(1, angle(10, 0));
+
+    // Ease is flat at both ends and halfway at the middle
+    channel.SetInterpolation(0, 0, AnimChannel::Interpolation::Ease);
+    ASSERT_DOUBLE_EQ(0.5, angle(5, 0));
+    ASSERT_LT(angle(1, 0), 0.1 / 2);
+    ASSERT_GT(angle(9, 0), 1 - 0.1 / 2);
+
+    // Catmull-Rom passes through the keyframes with the
+    // slope from the keyframe before to the one after
+    channel.SetInterpolation(0, 30, AnimChannel::Interpolation::CatmullRom);
+    ASSERT_DOUBLE_EQ(1, angle(10, 0));
+    ASSERT_DOUBLE_EQ(3, angle(20, 0));
+    double slope = (angle(10, 0.001) - angle(9, 0.999)) / 0.002;
+    ASSERT_NEAR(3.0 / 20, slope, 1e-4);
+
+    // Interpolation moves with the keyframes and a
+    // replaced value keeps its interpolation
+    channel.ShiftKeyframes(10, 10, 2);
+    ASSERT_EQ(AnimChannel::Interpolation::CatmullRom, channel.GetKeyframeInterpolation(1));
+    channel.SetKeyframe(12, 2.0);
+    ASSERT_EQ(AnimChannel::Interpolation::CatmullRom, channel.GetKeyframeInterpolation(1));
+    ASSERT_DOUBLE_EQ(2, angle(12, 0));
+}
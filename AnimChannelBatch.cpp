@@ -0,0 +1,65 @@
+/**
+ * @file AnimChannelBatch.cpp
+ * @author Noah Wolff
+ */
+
+#include "pch.h"
+#include "AnimChannelBatch.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+
+/**
+ * Evaluate packed arrays of cubics
+ *
+ * result[i] = ((c3[i] * t[i] + c2[i]) * t[i] + c1[i]) * t[i] + c0[i]
+ *
+ * where cp is the block of coefficients for t^p, starting at
+ * coefficients + p * stride. This is the same expression
+ * AnimChannelT uses, so batched and unbatched evaluation give
+ * the same values.
+ * @param coefficients Coefficients for t^0 for each component
+ * @param stride Distance from each block of coefficients to the next
+ * @param t The t value for each component
+ * @param result Array to fill with the evaluated components
+ * @param count Number of components
+ */
+void AnimCubic(const double *coefficients, int stride, const double *t, double *result, int count)
+{
+    const double *c0 = coefficients;
+    const double *c1 = coefficients + stride;
+    const double *c2 = coefficients + 2 * stride;
+    const double *c3 = coefficients + 3 * stride;
+
+    int i = 0;
+
+#if defined(__AVX__)
+    for ( ; i + 4 <= count; i += 4)
+    {
+        __m256d ti = _mm256_loadu_pd(t + i);
+        __m256d r = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(c3 + i), ti), _mm256_loadu_pd(c2 + i));
+        r = _mm256_add_pd(_mm256_mul_pd(r, ti), _mm256_loadu_pd(c1 + i));
+        r = _mm256_add_pd(_mm256_mul_pd(r, ti), _mm256_loadu_pd(c0 + i));
+        _mm256_storeu_pd(result + i, r);
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    for ( ; i + 2 <= count; i += 2)
+    {
+        __m128d ti = _mm_loadu_pd(t + i);
+        __m128d r = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(c3 + i), ti), _mm_loadu_pd(c2 + i));
+        r = _mm_add_pd(_mm_mul_pd(r, ti), _mm_loadu_pd(c1 + i));
+        r = _mm_add_pd(_mm_mul_pd(r, ti), _mm_loadu_pd(c0 + i));
+        _mm_storeu_pd(result + i, r);
+    }
+#endif
+
+    // Whatever is left over
+    for ( ; i < count; i++)
+    {
+        result[i] = ((c3[i] * t[i] + c2[i]) * t[i] + c1[i]) * t[i] + c0[i];
+    }
+}
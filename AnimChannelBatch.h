@@ -0,0 +1,160 @@
+/**
+ * @file AnimChannelBatch.h
+ * @author Noah Wolff
+ *
+ * Evaluates all of the channels of one value type together.
+ */
+
+#ifndef CANADIANEXPERIENCE_ANIMCHANNELBATCH_H
+#define CANADIANEXPERIENCE_ANIMCHANNELBATCH_H
+
+#include "AnimChannelT.h"
+#include "ThreadPool.h"
+
+void AnimCubic(const double *coefficients, int stride, const double *t, double *result, int count);
+
+
+/**
+ * Evaluates all of the channels of one value type together.
+ *
+ * Each channel is moved to the frame first. The channels that are
+ * between two keyframes have their segment coefficients and t values
+ * packed into flat arrays that are evaluated in one SIMD pass, and
+ * the results are written back to the channels.
+ *
+ * The channels can be split into chunks across a thread pool. Each
+ * chunk packs into its own part of the arrays, so the result does
+ * not depend on how the channels are split.
+ *
+ * @tparam Value The type of value the channels animate
+ */
+template <class Value>
+class AnimChannelBatch {
+private:
+    /// Number of components in a value
+    static const int Dim = AnimValueTraits<Value>::Dim;
+
+    /// All channels in the batch
+    std::vector<AnimChannelT<Value> *> mChannels;
+
+    /// Channels that need to be tweened on this frame. A chunk
+    /// of channels starting at index i packs them starting at i.
+    std::vector<AnimChannelT<Value> *> mTweening;
+
+    /// Packed segment coefficients, in four blocks of one
+    /// coefficient per component for the powers t^0 to t^3
+    std::vector<double> mCoefficients;
+
+    /// Packed t values, one per component
+    std::vector<double> mT;
+
+    /// Packed tweened components
+    std::vector<double> mResult;
+
+public:
+    /// Constructor
+    AnimChannelBatch() {}
+
+    /// Copy constructor (disabled)
+    AnimChannelBatch(const AnimChannelBatch &) = delete;
+
+    /// Assignment operator
+    void operator=(const AnimChannelBatch &) = delete;
+
+    /**
+     * Add a channel to the batch
+     * @param channel Channel to add
+     */
+    void Add(AnimChannelT<Value> *channel) { mChannels.push_back(channel); }
+
+    /**
+     * Set the value of every channel in the batch for a frame
+     * @param currFrame The frame we are on
+     * @param subframe Fraction of the way to the next frame, in [0, 1)
+     * @param pool Thread pool to split the channels across
+     */
+    void SetFrame(int currFrame, double subframe, ThreadPool &pool)
+    {
+        int count = (int)mChannels.size();
+        mTweening.resize(count);
+        mCoefficients.resize(4 * count * Dim);
+        mT.resize(count * Dim);
+        mResult.resize(count * Dim);
+
+        pool.ParallelFor(count, MinChunk, [this, currFrame, subframe](int begin, int end) {
+            SetFrame(currFrame, subframe, begin, end);
+        });
+    }
+
+    /**
+     * Set the value of every channel in the batch for a frame
+     * from the baked values, baking the channels that need it
+     * @param currFrame The frame we are on, in [0, number of frames)
+     * @param pool Thread pool to split the channels across
+     */
+    void SetBakedFrame(int currFrame, ThreadPool &pool)
+    {
+        pool.ParallelFor((int)mChannels.size(), MinChunk, [this, currFrame](int begin, int end) {
+            for (int i = begin; i < end; i++)
+            {
+                mChannels[i]->SetBakedFrame(currFrame);
+            }
+        });
+    }
+
+    /**
+     * Bake every channel in the batch that is not already baked
+     * @param pool Thread pool to split the channels across
+     */
+    void Bake(ThreadPool &pool)
+    {
+        pool.ParallelFor((int)mChannels.size(), MinChunk, [this](int begin, int end) {
+            for (int i = begin; i < end; i++)
+            {
+                if (mChannels[i]->IsValid() && !mChannels[i]->IsBaked())
+                {
+                    mChannels[i]->Bake();
+                }
+            }
+        });
+    }
+
+private:
+    /// Smallest number of channels worth giving to another thread
+    static const int MinChunk = 256;
+
+    /**
+     * Set the value of a range of channels for a frame
+     * @param currFrame The frame we are on
+     * @param subframe Fraction of the way to the next frame, in [0, 1)
+     * @param begin First channel in the range
+     * @param end One past the last channel in the range
+     */
+    void SetFrame(int currFrame, double subframe, int begin, int end)
+    {
+        int tweening = begin;
+        for (int i = begin; i < end; i++)
+        {
+            if (mChannels[i]->PrepareFrame(currFrame, subframe))
+            {
+                mTweening[tweening++] = mChannels[i];
+            }
+        }
+
+        int stride = (int)mT.size();
+        for (int i = begin; i < tweening; i++)
+        {
+            mTweening[i]->GetTweenInputs(&mCoefficients[i * Dim], stride, &mT[i * Dim]);
+        }
+
+        int first = begin * Dim;
+        AnimCubic(&mCoefficients[first], stride, &mT[first], &mResult[first], (tweening - begin) * Dim);
+
+        for (int i = begin; i < tweening; i++)
+        {
+            mTweening[i]->SetTweenResult(&mResult[i * Dim]);
+        }
+    }
+};
+
+#endif //CANADIANEXPERIENCE_ANIMCHANNELBATCH_H
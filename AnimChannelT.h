@@ -0,0 +1,646 @@
+/**
+ * @file AnimChannelT.h
+ * @author Noah Wolff
+ *
+ * Animation channel template for a keyframed value type.
+ */
+
+#ifndef CANADIANEXPERIENCE_ANIMCHANNELT_H
+#define CANADIANEXPERIENCE_ANIMCHANNELT_H
+
+#include "AnimChannel.h"
+#include <algorithm>
+#include <utility>
+
+
+/**
+ * How a value type is broken into components for tweening.
+ *
+ * Each value type a channel can animate specializes this
+ * to say how many double components it has and how to
+ * convert to and from an array of them.
+ */
+template <class Value>
+struct AnimValueTraits;
+
+/**
+ * Angles are a single component.
+ */
+template <>
+struct AnimValueTraits<double> {
+    /// Number of components
+    static const int Dim = 1;
+
+    /**
+     * Convert a value to components
+     * @param value Value to convert
+     * @param components Array of Dim components to fill
+     */
+    static void ToArray(double value, double *components) { components[0] = value; }
+
+    /**
+     * Convert components to a value
+     * @param components Array of Dim components
+     * @return The value
+     */
+    static double FromArray(const double *components) { return components[0]; }
+};
+
+/**
+ * Positions are an x and a y component. Conversion back
+ * to a point truncates.
+ */
+template <>
+struct AnimValueTraits<wxPoint> {
+    /// Number of components
+    static const int Dim = 2;
+
+    /**
+     * Convert a value to components
+     * @param value Value to convert
+     * @param components Array of Dim components to fill
+     */
+    static void ToArray(const wxPoint &value, double *components)
+    {
+        components[0] = value.x;
+        components[1] = value.y;
+    }
+
+    /**
+     * Convert components to a value
+     * @param components Array of Dim components
+     * @return The value
+     */
+    static wxPoint FromArray(const double *components)
+    {
+        return wxPoint(int(components[0]), int(components[1]));
+    }
+};
+
+
+/**
+ * Animation channel for a keyframed value type.
+ *
+ * The keyframe values are kept in a flat array parallel to the
+ * sorted keyframe frame numbers in AnimChannel, so keyframes cost
+ * no allocation of their own and tweening reads straight from
+ * the arrays.
+ *
+ * Each keyframe says how the value moves to the next keyframe.
+ * Whatever the interpolation, a segment between two keyframes is
+ * a cubic in t for each component. The cubic coefficients are
+ * computed for all of the segments when the keyframes change, so
+ * tweening is always three multiply-adds per component.
+ *
+ * @tparam Value The type of value animated. AnimValueTraits
+ * must be specialized for it.
+ */
+template <class Value>
+class AnimChannelT : public AnimChannel {
+private:
+    /// Component traits for the value type
+    using Traits = AnimValueTraits<Value>;
+
+    /// The keyframe values, parallel to the keyframe frame numbers
+    std::vector<Value> mValues;
+
+    /// How the value leaves each keyframe, parallel to the values
+    std::vector<Interpolation> mInterpolations;
+
+    /// Number of cubic coefficients per segment
+    static const int SegmentSize = 4 * Traits::Dim;
+
+    /// Cubic coefficients for each segment between keyframes. Segment k
+    /// starts at SegmentSize * k and holds the coefficients of t^0 to t^3
+    /// for each component in turn.
+    std::vector<double> mCoefficients;
+
+    /// Are the coefficients up to date with the keyframes?
+    bool mCoefficientsValid = false;
+
+    /// Current value of the channel
+    Value mValue = Value();
+
+    /// Value for mValueKeyframe1 when the value must be recomputed
+    static const int Stale = -2;
+
+    /// Keyframe 1 index the current value was computed from
+    int mValueKeyframe1 = Stale;
+
+    /// Keyframe 2 index the current value was computed from
+    int mValueKeyframe2 = Stale;
+
+    /// The t value the current value was tweened with
+    double mValueT = 0;
+
+    /// Did the last frame change the value?
+    bool mChanged = false;
+
+    /// Baked value for every frame of the timeline, empty if not baked
+    std::vector<Value> mBaked;
+
+    /**
+     * Store a keyframe value after its frame has been inserted
+     * @param keyframe Index of the keyframe
+     * @param value Value for the keyframe
+     */
+    void StoreKeyframe(int keyframe, const Value &value)
+    {
+        KeyframesChanged();
+
+        if ((int)mValues.size() < GetNumKeyframes())
+        {
+            mValues.insert(mValues.begin() + keyframe, value);
+            mInterpolations.insert(mInterpolations.begin() + keyframe, Interpolation::Linear);
+        }
+        else
+        {
+            mValues[keyframe] = value;
+        }
+    }
+
+    /**
+     * Note that the keyframes changed, so everything
+     * computed from them must be computed again
+     */
+    void KeyframesChanged()
+    {
+        mValueKeyframe1 = Stale;
+        mCoefficientsValid = false;
+        mBaked.clear();
+    }
+
+    /**
+     * Get the slope of the value at a keyframe for a Catmull-Rom
+     * segment, in value per frame
+     *
+     * The slope is the one from the keyframe before to the keyframe
+     * after, taking the frame spacing into account. The first and
+     * last keyframes use the slope to their only neighbour.
+     * @param keyframe Keyframe index
+     * @param slope Array of Dim components to fill
+     */
+    void GetSlope(int keyframe, double *slope) const
+    {
+        int prev = keyframe > 0 ? keyframe - 1 : keyframe;
+        int next = keyframe < GetNumKeyframes() - 1 ? keyframe + 1 : keyframe;
+
+        double a[Traits::Dim];
+        double b[Traits::Dim];
+        Traits::ToArray(mValues[prev], a);
+        Traits::ToArray(mValues[next], b);
+
+        double frames = GetKeyframeFrame(next) - GetKeyframeFrame(prev);
+        for (int d = 0; d < Traits::Dim; d++)
+        {
+            slope[d] = (b[d] - a[d]) / frames;
+        }
+    }
+
+    /**
+     * Compute the cubic coefficients for every segment
+     */
+    void UpdateCoefficients()
+    {
+        int numSegments = std::max(GetNumKeyframes() - 1, 0);
+        mCoefficients.resize(numSegments * SegmentSize);
+
+        for (int k = 0; k < numSegments; k++)
+        {
+            double p0[Traits::Dim];
+            double p1[Traits::Dim];
+            Traits::ToArray(mValues[k], p0);
+            Traits::ToArray(mValues[k + 1], p1);
+
+            // Hermite tangents, in value per unit of t
+            double m0[Traits::Dim] = {};
+            double m1[Traits::Dim] = {};
+            if (mInterpolations[k] == Interpolation::CatmullRom)
+            {
+                double frames = GetKeyframeFrame(k + 1) - GetKeyframeFrame(k);
+                GetSlope(k, m0);
+                GetSlope(k + 1, m1);
+                for (int d = 0; d < Traits::Dim; d++)
+                {
+                    m0[d] *= frames;
+                    m1[d] *= frames;
+                }
+            }
+
+            double *c = &mCoefficients[k * SegmentSize];
+            for (int d = 0; d < Traits::Dim; d++, c += 4)
+            {
+                double delta = p1[d] - p0[d];
+                c[0] = p0[d];
+                switch (mInterpolations[k])
+                {
+                case Interpolation::Linear:
+                    c[1] = delta;
+                    c[2] = 0;
+                    c[3] = 0;
+                    break;
+
+                case Interpolation::Step:
+                    c[1] = 0;
+                    c[2] = 0;
+                    c[3] = 0;
+                    break;
+
+                case Interpolation::CatmullRom:
+                case Interpolation::Ease:
+                    // Cubic Hermite. Ease is a Bezier with its handles
+                    // flat on the keyframe values, so the tangents are zero.
+                    c[1] = m0[d];
+                    c[2] = 3 * delta - 2 * m0[d] - m1[d];
+                    c[3] = -2 * delta + m0[d] + m1[d];
+                    break;
+                }
+            }
+        }
+
+        mCoefficientsValid = true;
+    }
+
+    /**
+     * Evaluate a segment
+     * @param segment Index of the keyframe the segment starts at
+     * @param t A t value in [0, 1]
+     * @return Value on the segment at t
+     */
+    Value Evaluate(int segment, double t) const
+    {
+        double components[Traits::Dim];
+        const double *c = &mCoefficients[segment * SegmentSize];
+        for (int d = 0; d < Traits::Dim; d++, c += 4)
+        {
+            components[d] = ((c[3] * t + c[2]) * t + c[1]) * t + c[0];
+        }
+
+        return Traits::FromArray(components);
+    }
+
+    /**
+     * Set the channel value, noting if it changed
+     * @param value New value
+     */
+    void SetValue(const Value &value)
+    {
+        mChanged = !(value == mValue);
+        mValue = value;
+    }
+
+protected:
+    /// Default constructor
+    AnimChannelT() {}
+
+    /**
+     * Rearrange the keyframe values after the keyframe frame
+     * numbers have been rearranged
+     * @param source For each new keyframe, the index of the
+     * old keyframe whose value it takes
+     */
+    void RemapValues(const std::vector<int> &source) override
+    {
+        std::vector<Value> values(source.size());
+        std::vector<Interpolation> interpolations(source.size());
+        for (int i = 0; i < (int)source.size(); i++)
+        {
+            values[i] = mValues[source[i]];
+            interpolations[i] = mInterpolations[source[i]];
+        }
+
+        mValues.swap(values);
+        mInterpolations.swap(interpolations);
+        KeyframesChanged();
+    }
+
+    /**
+     * Set the interpolation of a range of keyframes
+     * @param begin First keyframe index
+     * @param end One past the last keyframe index
+     * @param interpolation How to leave each of the keyframes
+     */
+    void SetInterpolations(int begin, int end, Interpolation interpolation) override
+    {
+        std::fill(mInterpolations.begin() + begin, mInterpolations.begin() + end, interpolation);
+        KeyframesChanged();
+    }
+
+public:
+    /// Copy constructor (disabled)
+    AnimChannelT(const AnimChannelT &) = delete;
+
+    /// Assignment operator
+    void operator=(const AnimChannelT &) = delete;
+
+    /**
+     * Set a keyframe at the current frame
+     *
+     * If there is already a keyframe on this frame, its value
+     * is replaced and it keeps its interpolation. New keyframes
+     * are linear.
+     * @param value Value for the keyframe
+     */
+    void SetKeyframe(const Value &value)
+    {
+        StoreKeyframe(InsertFrame(), value);
+    }
+
+    /**
+     * Set a keyframe at any frame
+     *
+     * This does not depend on the current frame. If there is
+     * already a keyframe on the frame, its value is replaced.
+     * @param frame Frame for the keyframe
+     * @param value Value for the keyframe
+     */
+    void SetKeyframe(int frame, const Value &value)
+    {
+        StoreKeyframe(InsertFrame(frame), value);
+    }
+
+    /**
+     * Set many keyframes at once
+     *
+     * The keyframes are merged with the existing ones in one pass.
+     * Keyframes on a frame that already has one replace it. If
+     * the same frame is given more than once, the last one wins.
+     * @param keyframes Frame and value for each keyframe, in any order
+     */
+    void SetKeyframes(std::vector<std::pair<int, Value>> keyframes)
+    {
+        std::stable_sort(keyframes.begin(), keyframes.end(),
+                [](const std::pair<int, Value> &a, const std::pair<int, Value> &b) { return a.first < b.first; });
+
+        std::vector<int> frames;
+        for (auto const &keyframe : keyframes)
+        {
+            frames.push_back(keyframe.first);
+        }
+
+        std::vector<int> source;
+        MergeFrames(frames, source);
+
+        std::vector<Value> values(source.size());
+        std::vector<Interpolation> interpolations(source.size(), Interpolation::Linear);
+        for (int i = 0; i < (int)source.size(); i++)
+        {
+            if (source[i] >= 0)
+            {
+                values[i] = mValues[source[i]];
+                interpolations[i] = mInterpolations[source[i]];
+            }
+            else
+            {
+                values[i] = keyframes[-1 - source[i]].second;
+            }
+        }
+
+        mValues.swap(values);
+        mInterpolations.swap(interpolations);
+        KeyframesChanged();
+    }
+
+    /**
+     * Set the channel value for a frame
+     *
+     * Tweens between the keyframes on either side of
+     * the frame, or uses the only keyframe if we are
+     * before the first or after the last.
+     * @param currFrame The frame we are on
+     * @param subframe Fraction of the way to the next frame, in [0, 1)
+     */
+    void SetFrame(int currFrame, double subframe = 0) override
+    {
+        if (PrepareFrame(currFrame, subframe))
+        {
+            // Between two keyframes, so we tween
+            SetValue(Evaluate(GetKeyframe1(), mValueT));
+        }
+    }
+
+    /**
+     * Set the channel value for a frame from the baked values,
+     * baking the channel first if needed
+     * @param currFrame The frame we are on, in [0, number of frames)
+     */
+    void SetBakedFrame(int currFrame) override
+    {
+        if (!IsValid())
+        {
+            return;
+        }
+
+        if (!IsBaked())
+        {
+            Bake();
+        }
+
+        SetValue(mBaked[currFrame]);
+
+        // The keyframe indices were not moved, so the next
+        // SetFrame or PrepareFrame must recompute the value
+        mValueKeyframe1 = Stale;
+    }
+
+    /**
+     * Evaluate the channel for every frame of the timeline.
+     *
+     * This walks the frames in order, so it is one pass over
+     * the keyframes. The values are the ones SetFrame computes
+     * with a subframe of 0.
+     */
+    void Bake() override
+    {
+        int numFrames = GetNumFrames();
+        int numKeyframes = GetNumKeyframes();
+
+        mBaked.resize(numFrames);
+        if (!mCoefficientsValid)
+        {
+            UpdateCoefficients();
+        }
+
+        // First keyframe after the frame
+        int next = 0;
+        for (int frame = 0; frame < numFrames; frame++)
+        {
+            while (next < numKeyframes && GetKeyframeFrame(next) <= frame)
+            {
+                next++;
+            }
+
+            if (next > 0 && next < numKeyframes)
+            {
+                double t = GetTweenT(next - 1, next, frame, 0);
+                mBaked[frame] = Evaluate(next - 1, t);
+            }
+            else if (next > 0)
+            {
+                mBaked[frame] = mValues[next - 1];
+            }
+            else if (numKeyframes > 0)
+            {
+                mBaked[frame] = mValues[0];
+            }
+        }
+    }
+
+    /**
+     * Are the baked values up to date?
+     *
+     * Setting a keyframe or changing the number of frames
+     * in the timeline means the channel must be baked again.
+     * @return true if baked
+     */
+    bool IsBaked() const override { return !mBaked.empty() && (int)mBaked.size() == GetNumFrames(); }
+
+    /**
+     * Move to a frame, setting the value unless it must be tweened.
+     *
+     * If we are only after or only before a keyframe, the channel
+     * value is set from that keyframe. If we are between two keyframes,
+     * the value is left for the caller to tween, either with SetFrame
+     * or in a batch with GetTweenInputs and SetTweenResult.
+     *
+     * Nothing is recomputed if the value would be the same as the last
+     * time: holding on the same keyframe, or tweening the same keyframes
+     * with the same t. IsChanged tells if the value changed.
+     * @param currFrame The frame we are on
+     * @param subframe Fraction of the way to the next frame, in [0, 1)
+     * @return true if the value must be tweened
+     */
+    bool PrepareFrame(int currFrame, double subframe)
+    {
+        if (!mCoefficientsValid)
+        {
+            UpdateCoefficients();
+        }
+
+        Seek(currFrame);
+
+        int keyframe1 = GetKeyframe1();
+        int keyframe2 = GetKeyframe2();
+        bool sameKeyframes = keyframe1 == mValueKeyframe1 && keyframe2 == mValueKeyframe2;
+        mValueKeyframe1 = keyframe1;
+        mValueKeyframe2 = keyframe2;
+
+        if (keyframe1 >= 0 && keyframe2 >= 0)
+        {
+            double t = GetTweenT(keyframe1, keyframe2, currFrame, subframe);
+            if (sameKeyframes && t == mValueT)
+            {
+                mChanged = false;
+                return false;
+            }
+
+            mValueT = t;
+            return true;
+        }
+
+        if (sameKeyframes)
+        {
+            // Holding on the same keyframe as last time
+            mChanged = false;
+        }
+        else if (keyframe1 >= 0)
+        {
+            // Only a keyframe to the left
+            SetValue(mValues[keyframe1]);
+        }
+        else if (keyframe2 >= 0)
+        {
+            // Only a keyframe to the right
+            SetValue(mValues[keyframe2]);
+        }
+
+        return false;
+    }
+
+    /**
+     * Get the inputs for tweening the current frame
+     *
+     * Only valid after PrepareFrame returns true. The coefficients
+     * are written in four blocks of Dim components, one block
+     * for each power of t from t^0 to t^3.
+     * @param coefficients Where to write the t^0 block
+     * @param stride Distance from each block to the next
+     * @param t Array of Dim t values, all the same
+     */
+    void GetTweenInputs(double *coefficients, int stride, double *t) const
+    {
+        const double *c = &mCoefficients[GetKeyframe1() * SegmentSize];
+        for (int d = 0; d < Traits::Dim; d++, c += 4)
+        {
+            for (int p = 0; p < 4; p++)
+            {
+                coefficients[p * stride + d] = c[p];
+            }
+
+            t[d] = mValueT;
+        }
+    }
+
+    /**
+     * Set the channel value from tweened components
+     * @param components Array of Dim components
+     */
+    void SetTweenResult(const double *components) { SetValue(Traits::FromArray(components)); }
+
+    /**
+     * Get the current value of the channel
+     * @return Channel value
+     */
+    const Value &GetValue() const { return mValue; }
+
+    /**
+     * Did the value change on the last frame we moved to?
+     * @return true if changed
+     */
+    bool IsChanged() const { return mChanged; }
+
+    /**
+     * Does this channel hold the same value on every frame?
+     *
+     * True if there are no keyframes or all of them have the
+     * same value, so evaluating the channel never changes anything.
+     * @return true if constant
+     */
+    bool IsConstant() const
+    {
+        for (auto const &value : mValues)
+        {
+            if (!(value == mValues[0]))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * Get the baked value for a frame
+     *
+     * The channel must be valid and baked.
+     * @param frame Frame, in [0, number of frames)
+     * @return Value on the frame
+     */
+    const Value &GetBakedValue(int frame) const { return mBaked[frame]; }
+
+    /**
+     * Get the value of a keyframe
+     * @param keyframe Keyframe index
+     * @return Keyframe value
+     */
+    const Value &GetKeyframeValue(int keyframe) const { return mValues[keyframe]; }
+
+    /**
+     * Get how the value leaves a keyframe
+     * @param keyframe Keyframe index
+     * @return Keyframe interpolation
+     */
+    Interpolation GetKeyframeInterpolation(int keyframe) const { return mInterpolations[keyframe]; }
+};
+
+#endif //CANADIANEXPERIENCE_ANIMCHANNELT_H
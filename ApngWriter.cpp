@@ -0,0 +1,249 @@
+/**
+ * @file ApngWriter.cpp
+ * @author Noah Wolff
+ */
+
+#include "pch.h"
+#include "ApngWriter.h"
+#include "RenderImage.h"
+#include <wx/mstream.h>
+#include <wx/zstream.h>
+#include <cstdlib>
+
+/// Bytes every PNG file starts with
+const unsigned char PngSignature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+
+/// Bytes in each RGBA pixel
+const int BytesPerPixel = 4;
+
+/// PNG filter type for the Paeth predictor
+const unsigned char PaethFilter = 4;
+
+/**
+ * Append a number to chunk data, most significant byte first
+ * @param data Data to append to
+ * @param value Value to append
+ */
+static void Put32(std::string &data, uint32_t value)
+{
+    for (int shift = 24; shift >= 0; shift -= 8)
+    {
+        data.push_back((char)(value >> shift));
+    }
+}
+
+/**
+ * Append a 16 bit number to chunk data, most significant byte first
+ * @param data Data to append to
+ * @param value Value to append
+ */
+static void Put16(std::string &data, int value)
+{
+    data.push_back((char)(value >> 8));
+    data.push_back((char)value);
+}
+
+/**
+ * The Paeth predictor from the PNG specification
+ * @param left Byte to the left
+ * @param up Byte above
+ * @param upLeft Byte above and to the left
+ * @return Whichever of the three is closest to left + up - upLeft
+ */
+static int Paeth(int left, int up, int upLeft)
+{
+    int p = left + up - upLeft;
+    int pa = std::abs(p - left);
+    int pb = std::abs(p - up);
+    int pc = std::abs(p - upLeft);
+    if (pa <= pb && pa <= pc)
+    {
+        return left;
+    }
+
+    return pb <= pc ? up : upLeft;
+}
+
+/**
+ * Constructor
+ * @param out Stream to write to, opened in binary mode
+ */
+ApngWriter::ApngWriter(std::ostream &out) : VideoWriter(out)
+{
+}
+
+/**
+ * Start the video by writing the PNG header and animation control
+ * @param width Width of the frames in pixels
+ * @param height Height of the frames in pixels
+ * @param frameRate Frames per second
+ * @param numFrames Number of frames that will be written
+ * @return true if the stream is good
+ */
+bool ApngWriter::Begin(int width, int height, int frameRate, int numFrames)
+{
+    VideoWriter::Begin(width, height, frameRate, numFrames);
+    mSequence = 0;
+    mFramesWritten = 0;
+
+    Write(PngSignature, sizeof(PngSignature));
+
+    // 8 bits per channel, RGBA, no interlacing
+    std::string header;
+    Put32(header, width);
+    Put32(header, height);
+    header.append({8, 6, 0, 0, 0});
+    WriteChunk("IHDR", header);
+
+    // Play forever
+    std::string control;
+    Put32(control, numFrames);
+    Put32(control, 0);
+    WriteChunk("acTL", control);
+
+    return GetStream().good();
+}
+
+/**
+ * Write the next frame
+ *
+ * The first frame is the default image everyone sees, the rest
+ * go in frame data chunks.
+ * @param image Frame, the size given to Begin
+ * @return true if the stream is still good
+ */
+bool ApngWriter::WriteFrame(const RenderImage &image)
+{
+    int width = image.GetWidth();
+    int height = image.GetHeight();
+    size_t rowBytes = (size_t)width * BytesPerPixel;
+
+    // Filter every row against the one above it, which
+    // starts out as zeros for the first row
+    mRows.assign(rowBytes * 2, 0);
+    mFiltered.resize((rowBytes + 1) * height);
+    unsigned char *filtered = mFiltered.data();
+    const uint32_t *pixels = image.GetPixels();
+    for (int y = 0; y < height; y++)
+    {
+        unsigned char *up = mRows.data() + (y % 2) * rowBytes;
+        unsigned char *row = mRows.data() + ((y + 1) % 2) * rowBytes;
+        for (int x = 0; x < width; x++)
+        {
+            uint32_t pixel = RenderImage::Unpremultiply(pixels[x]);
+            for (int c = 0; c < BytesPerPixel; c++)
+            {
+                row[x * BytesPerPixel + c] = (unsigned char)(pixel >> (c * 8));
+            }
+        }
+
+        *filtered++ = PaethFilter;
+        for (size_t i = 0; i < rowBytes; i++)
+        {
+            int left = i < BytesPerPixel ? 0 : row[i - BytesPerPixel];
+            int upLeft = i < BytesPerPixel ? 0 : up[i - BytesPerPixel];
+            *filtered++ = (unsigned char)(row[i] - Paeth(left, up[i], upLeft));
+        }
+
+        pixels += width;
+    }
+
+    wxMemoryOutputStream compressed;
+    {
+        wxZlibOutputStream zlib(compressed, wxZ_BEST_SPEED);
+        zlib.Write(mFiltered.data(), mFiltered.size());
+        zlib.Close();
+    }
+
+    // The whole frame, shown for 1/frameRate seconds,
+    // replacing what was there
+    std::string control;
+    Put32(control, mSequence++);
+    Put32(control, width);
+    Put32(control, height);
+    Put32(control, 0);
+    Put32(control, 0);
+    Put16(control, 1);
+    Put16(control, GetFrameRate());
+    control.append({0, 0});
+    WriteChunk("fcTL", control);
+
+    std::string data;
+    if (mFramesWritten > 0)
+    {
+        Put32(data, mSequence++);
+    }
+
+    size_t start = data.size();
+    data.resize(start + compressed.GetLength());
+    compressed.CopyTo(&data[start], compressed.GetLength());
+    WriteChunk(mFramesWritten == 0 ? "IDAT" : "fdAT", data);
+
+    mFramesWritten++;
+    return GetStream().good();
+}
+
+/**
+ * Finish the file
+ * @return true if everything was written and there were
+ * as many frames as Begin was told about
+ */
+bool ApngWriter::End()
+{
+    WriteChunk("IEND", std::string());
+    return VideoWriter::End() && mFramesWritten == GetNumFrames();
+}
+
+/**
+ * Write one PNG chunk
+ * @param type Four letter chunk type
+ * @param data Chunk data
+ */
+void ApngWriter::WriteChunk(const char *type, const std::string &data)
+{
+    std::string length;
+    Put32(length, (uint32_t)data.size());
+    Write(length.data(), length.size());
+    Write(type, 4);
+    Write(data.data(), data.size());
+
+    uint32_t crc = Crc((const unsigned char *)type, 4);
+    crc = Crc((const unsigned char *)data.data(), data.size(), crc);
+    std::string check;
+    Put32(check, crc);
+    Write(check.data(), check.size());
+}
+
+/**
+ * Compute the CRC-32 PNG uses to check chunks
+ * @param data Bytes to check
+ * @param size Number of bytes
+ * @param crc CRC of the bytes before these, to continue it
+ * @return CRC of all of the bytes so far
+ */
+uint32_t ApngWriter::Crc(const unsigned char *data, size_t size, uint32_t crc)
+{
+    static const auto table = []() {
+        std::vector<uint32_t> table(256);
+        for (uint32_t n = 0; n < 256; n++)
+        {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++)
+            {
+                c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+            }
+
+            table[n] = c;
+        }
+
+        return table;
+    }();
+
+    crc ^= 0xffffffffu;
+    for (size_t i = 0; i < size; i++)
+    {
+        crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    }
+
+    return crc ^ 0xffffffffu;
+}
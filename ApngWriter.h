@@ -0,0 +1,53 @@
+/**
+ * @file ApngWriter.h
+ * @author Noah Wolff
+ *
+ * Writes frames as an animated PNG.
+ */
+
+#ifndef CANADIANEXPERIENCE_APNGWRITER_H
+#define CANADIANEXPERIENCE_APNGWRITER_H
+
+#include <string>
+#include <vector>
+#include "VideoWriter.h"
+
+
+/**
+ * Writes frames as an animated PNG.
+ *
+ * The frames are whole RGBA images that each replace the last,
+ * compressed as they are written. Browsers play the result and it
+ * keeps the alpha channel. The number of frames goes in the
+ * header, so exactly as many frames as were given to Begin must
+ * be written. Viewers that don't know APNG show the first frame.
+ */
+class ApngWriter : public VideoWriter {
+private:
+    /// Sequence number of the next fcTL or fdAT chunk
+    uint32_t mSequence = 0;
+
+    /// Number of frames written so far
+    int mFramesWritten = 0;
+
+    /// Filtered rows of the frame being written, reused for every frame
+    std::vector<unsigned char> mFiltered;
+
+    /// Unpremultiplied rows the filter works on, the row above and this one
+    std::vector<unsigned char> mRows;
+
+    void WriteChunk(const char *type, const std::string &data);
+
+public:
+    ApngWriter(std::ostream &out);
+
+    bool Begin(int width, int height, int frameRate, int numFrames) override;
+
+    bool WriteFrame(const RenderImage &image) override;
+
+    bool End() override;
+
+    static uint32_t Crc(const unsigned char *data, size_t size, uint32_t crc = 0);
+};
+
+#endif //CANADIANEXPERIENCE_APNGWRITER_H
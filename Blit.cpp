@@ -0,0 +1,426 @@
+/**
+ * @file Blit.cpp
+ * @author Noah Wolff
+ */
+
+#include "pch.h"
+#include "Blit.h"
+#include "RenderImage.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+/// Pixels done at a time by the bilinear kernel
+const int BlitChunk = 64;
+
+/// Bits after the point in the fixed point image coordinates
+const int FixedBits = 16;
+
+/**
+ * The inputs for bilinear sampling of a run of pixels
+ *
+ * Each pixel gets the four image pixels around its sample point,
+ * and the weights of the right and lower ones repeated for each
+ * channel, so the vector code can load them as they are.
+ */
+struct BilinearInputs
+{
+    uint32_t mTopLeft[BlitChunk];       ///< Image pixel up and to the left
+    uint32_t mTopRight[BlitChunk];      ///< Image pixel up and to the right
+    uint32_t mBottomLeft[BlitChunk];    ///< Image pixel down and to the left
+    uint32_t mBottomRight[BlitChunk];   ///< Image pixel down and to the right
+    uint16_t mRightWeight[BlitChunk * 4];   ///< Weight of the right pixels, 0 to 255
+    uint16_t mBottomWeight[BlitChunk * 4];  ///< Weight of the bottom pixels, 0 to 255
+};
+
+/**
+ * Multiply two values in 0 to 255 as if they were fractions
+ * @param value Value
+ * @param scale Scale
+ * @return value * scale / 255, rounded
+ */
+static inline uint32_t Mul255(uint32_t value, uint32_t scale)
+{
+    uint32_t t = value * scale + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+/**
+ * Mix one channel of two pixels
+ * @param a First value
+ * @param b Second value
+ * @param weight How much of b, 0 to 255
+ * @return Mixed value
+ */
+static inline uint32_t Lerp(uint32_t a, uint32_t b, uint32_t weight)
+{
+    return (a * (256 - weight) + b * weight + 128) >> 8;
+}
+
+/**
+ * Sample bilinearly and put the result over the target,
+ * one pixel and one channel at a time
+ * @param dst Target pixels
+ * @param inputs Sampling inputs
+ * @param begin First pixel to do
+ * @param end One past the last pixel to do
+ */
+static void BilinearScalar(uint32_t *dst, const BilinearInputs &inputs, int begin, int end)
+{
+    for (int i = begin; i < end; i++)
+    {
+        uint32_t wu = inputs.mRightWeight[i * 4];
+        uint32_t wv = inputs.mBottomWeight[i * 4];
+
+        uint32_t src[4];
+        for (int c = 0; c < 4; c++)
+        {
+            int shift = c * 8;
+            uint32_t top = Lerp((inputs.mTopLeft[i] >> shift) & 0xff, (inputs.mTopRight[i] >> shift) & 0xff, wu);
+            uint32_t bottom = Lerp((inputs.mBottomLeft[i] >> shift) & 0xff, (inputs.mBottomRight[i] >> shift) & 0xff, wu);
+            src[c] = Lerp(top, bottom, wv);
+        }
+
+        uint32_t pixel = 0;
+        for (int c = 0; c < 4; c++)
+        {
+            int shift = c * 8;
+            pixel |= (src[c] + Mul255((dst[i] >> shift) & 0xff, 255 - src[3])) << shift;
+        }
+
+        dst[i] = pixel;
+    }
+}
+
+/**
+ * Put premultiplied pixels over others, one at a time
+ * @param dst Pixels underneath, replaced with the result
+ * @param src Pixels on top
+ * @param begin First pixel to do
+ * @param end One past the last pixel to do
+ */
+static void BlendScalar(uint32_t *dst, const uint32_t *src, int begin, int end)
+{
+    for (int i = begin; i < end; i++)
+    {
+        uint32_t inverse = 255 - (src[i] >> 24);
+        uint32_t pixel = 0;
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            pixel |= (((src[i] >> shift) & 0xff) + Mul255((dst[i] >> shift) & 0xff, inverse)) << shift;
+        }
+
+        dst[i] = pixel;
+    }
+}
+
+#if defined(__AVX2__)
+
+/**
+ * Mix pixels with 16 bit channels
+ * @param a First pixels
+ * @param b Second pixels
+ * @param weight How much of b for each channel, 0 to 255
+ * @return Mixed pixels
+ */
+static inline __m256i Lerp16(__m256i a, __m256i b, __m256i weight)
+{
+    __m256i r = _mm256_add_epi16(_mm256_mullo_epi16(a, _mm256_sub_epi16(_mm256_set1_epi16(256), weight)),
+            _mm256_mullo_epi16(b, weight));
+    return _mm256_srli_epi16(_mm256_add_epi16(r, _mm256_set1_epi16(128)), 8);
+}
+
+/**
+ * Put premultiplied pixels with 16 bit channels over others
+ * @param src Pixels on top
+ * @param dst Pixels underneath
+ * @return Blended pixels
+ */
+static inline __m256i Over16(__m256i src, __m256i dst)
+{
+    __m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(src, 0xff), 0xff);
+    __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(dst, _mm256_sub_epi16(_mm256_set1_epi16(255), alpha)),
+            _mm256_set1_epi16(128));
+    t = _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+    return _mm256_add_epi16(src, t);
+}
+
+/**
+ * Load four pixels with 16 bit channels
+ * @param pixels First pixel
+ * @return Pixels
+ */
+static inline __m256i Load4(const uint32_t *pixels)
+{
+    return _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)pixels));
+}
+
+/**
+ * Store four pixels with 16 bit channels
+ * @param pixels Where to store the first pixel
+ * @param value Pixels
+ */
+static inline void Store4(uint32_t *pixels, __m256i value)
+{
+    __m128i packed = _mm_packus_epi16(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1));
+    _mm_storeu_si128((__m128i *)pixels, packed);
+}
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+/**
+ * Mix pixels with 16 bit channels
+ * @param a First pixels
+ * @param b Second pixels
+ * @param weight How much of b for each channel, 0 to 255
+ * @return Mixed pixels
+ */
+static inline __m128i Lerp16(__m128i a, __m128i b, __m128i weight)
+{
+    __m128i r = _mm_add_epi16(_mm_mullo_epi16(a, _mm_sub_epi16(_mm_set1_epi16(256), weight)),
+            _mm_mullo_epi16(b, weight));
+    return _mm_srli_epi16(_mm_add_epi16(r, _mm_set1_epi16(128)), 8);
+}
+
+/**
+ * Put premultiplied pixels with 16 bit channels over others
+ * @param src Pixels on top
+ * @param dst Pixels underneath
+ * @return Blended pixels
+ */
+static inline __m128i Over16(__m128i src, __m128i dst)
+{
+    __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src, 0xff), 0xff);
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(dst, _mm_sub_epi16(_mm_set1_epi16(255), alpha)),
+            _mm_set1_epi16(128));
+    t = _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+    return _mm_add_epi16(src, t);
+}
+
+/**
+ * Load two pixels with 16 bit channels
+ * @param pixels First pixel
+ * @return Pixels
+ */
+static inline __m128i Load2(const uint32_t *pixels)
+{
+    return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)pixels), _mm_setzero_si128());
+}
+
+/**
+ * Store two pixels with 16 bit channels
+ * @param pixels Where to store the first pixel
+ * @param value Pixels
+ */
+static inline void Store2(uint32_t *pixels, __m128i value)
+{
+    _mm_storel_epi64((__m128i *)pixels, _mm_packus_epi16(value, _mm_setzero_si128()));
+}
+
+#endif
+
+/**
+ * Sample bilinearly and put the result over the target
+ *
+ * The vector code does the same integer arithmetic
+ * as the scalar code, so they give the same pixels.
+ * @param dst Target pixels
+ * @param inputs Sampling inputs
+ * @param count Number of pixels
+ */
+static void Bilinear(uint32_t *dst, const BilinearInputs &inputs, int count)
+{
+    int i = 0;
+
+#if defined(__AVX2__)
+    for ( ; i + 4 <= count; i += 4)
+    {
+        __m256i wu = _mm256_loadu_si256((const __m256i *)&inputs.mRightWeight[i * 4]);
+        __m256i wv = _mm256_loadu_si256((const __m256i *)&inputs.mBottomWeight[i * 4]);
+        __m256i top = Lerp16(Load4(&inputs.mTopLeft[i]), Load4(&inputs.mTopRight[i]), wu);
+        __m256i bottom = Lerp16(Load4(&inputs.mBottomLeft[i]), Load4(&inputs.mBottomRight[i]), wu);
+        Store4(dst + i, Over16(Lerp16(top, bottom, wv), Load4(dst + i)));
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    for ( ; i + 2 <= count; i += 2)
+    {
+        __m128i wu = _mm_loadu_si128((const __m128i *)&inputs.mRightWeight[i * 4]);
+        __m128i wv = _mm_loadu_si128((const __m128i *)&inputs.mBottomWeight[i * 4]);
+        __m128i top = Lerp16(Load2(&inputs.mTopLeft[i]), Load2(&inputs.mTopRight[i]), wu);
+        __m128i bottom = Lerp16(Load2(&inputs.mBottomLeft[i]), Load2(&inputs.mBottomRight[i]), wu);
+        Store2(dst + i, Over16(Lerp16(top, bottom, wv), Load2(dst + i)));
+    }
+#endif
+
+    // Whatever is left over
+    BilinearScalar(dst, inputs, i, count);
+}
+
+/**
+ * Put premultiplied pixels over others
+ * @param dst Pixels underneath, replaced with the result
+ * @param src Pixels on top
+ * @param count Number of pixels
+ */
+void BlendRow(uint32_t *dst, const uint32_t *src, int count)
+{
+    int i = 0;
+
+#if defined(__AVX2__)
+    for ( ; i + 4 <= count; i += 4)
+    {
+        Store4(dst + i, Over16(Load4(src + i), Load4(dst + i)));
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    for ( ; i + 2 <= count; i += 2)
+    {
+        Store2(dst + i, Over16(Load2(src + i), Load2(dst + i)));
+    }
+#endif
+
+    BlendScalar(dst, src, i, count);
+}
+
+/**
+ * Get a pixel of an image, transparent outside of it
+ * @param image Image
+ * @param x Column
+ * @param y Row
+ * @return Premultiplied pixel
+ */
+static inline uint32_t Texel(const RenderImage &image, int x, int y)
+{
+    if (x < 0 || y < 0 || x >= image.GetWidth() || y >= image.GetHeight())
+    {
+        return 0;
+    }
+
+    return image.GetPixel(x, y);
+}
+
+/**
+ * Draw an image that is only moved by whole pixels
+ * @param image Image to draw
+ * @param left Column of the target the image starts at
+ * @param top Row of the target the image starts at
+ * @param target Image to draw onto
+ */
+static void BlitAligned(const RenderImage &image, int left, int top, RenderImage &target)
+{
+    int x0 = std::max(0, left);
+    int y0 = std::max(0, top);
+    int x1 = std::min(target.GetWidth(), left + image.GetWidth());
+    int y1 = std::min(target.GetHeight(), top + image.GetHeight());
+    for (int y = y0; y < y1; y++)
+    {
+        BlendRow(target.GetPixels() + (size_t)y * target.GetWidth() + x0,
+                image.GetPixels() + (size_t)(y - top) * image.GetWidth() + (x0 - left),
+                x1 - x0);
+    }
+}
+
+/**
+ * Draw a premultiplied image onto another
+ *
+ * Each target pixel is mapped back into the image and sampled
+ * bilinearly, so rotated images are smooth and their edges are
+ * antialiased. Image pixel centers are on half pixels, so an image
+ * moved only by whole pixels is copied exactly, and that case skips
+ * the sampling. The image coordinates are stepped in 16.16 fixed
+ * point along each row, so images up to 32767 pixels will work.
+ * @param image Image to draw, with its top left corner at (0, 0)
+ * @param transform Transformation from image pixels to the target
+ * @param target Image to draw onto
+ */
+void BlitImage(const RenderImage &image, const Affine &transform, RenderImage &target)
+{
+    int width = image.GetWidth();
+    int height = image.GetHeight();
+    if (width == 0 || height == 0)
+    {
+        return;
+    }
+
+    auto origin = transform.GetTranslation();
+    if (transform.GetA() == 1 && transform.GetB() == 0 && transform.GetC() == 0 && transform.GetD() == 1 &&
+            origin.m_x == floor(origin.m_x) && origin.m_y == floor(origin.m_y))
+    {
+        BlitAligned(image, (int)origin.m_x, (int)origin.m_y, target);
+        return;
+    }
+
+    double left = INFINITY;
+    double top = INFINITY;
+    double right = -INFINITY;
+    double bottom = -INFINITY;
+    for (int corner = 0; corner < 4; corner++)
+    {
+        auto p = transform.Apply(wxPoint2DDouble((corner & 1) ? width : 0, (corner & 2) ? height : 0));
+        left = std::min(left, p.m_x);
+        top = std::min(top, p.m_y);
+        right = std::max(right, p.m_x);
+        bottom = std::max(bottom, p.m_y);
+    }
+
+    // Bilinear sampling reaches half a pixel past the image
+    int x0 = std::max(0, (int)floor(left) - 1);
+    int y0 = std::max(0, (int)floor(top) - 1);
+    int x1 = std::min(target.GetWidth(), (int)ceil(right) + 1);
+    int y1 = std::min(target.GetHeight(), (int)ceil(bottom) + 1);
+
+    Affine inverse = transform.Inverse();
+    const double one = 1 << FixedBits;
+    auto du = (int32_t)lround(inverse.GetA() * one);
+    auto dv = (int32_t)lround(inverse.GetB() * one);
+
+    BilinearInputs inputs;
+    for (int y = y0; y < y1; y++)
+    {
+        uint32_t *row = target.GetPixels() + (size_t)y * target.GetWidth();
+
+        // Where the first pixel center in the row samples the image
+        auto start = inverse.Apply(wxPoint2DDouble(x0 + 0.5, y + 0.5));
+        auto u = (int32_t)lround((start.m_x - 0.5) * one);
+        auto v = (int32_t)lround((start.m_y - 0.5) * one);
+
+        for (int x = x0; x < x1; x += BlitChunk)
+        {
+            int count = std::min(BlitChunk, x1 - x);
+            for (int i = 0; i < count; i++, u += du, v += dv)
+            {
+                int iu = u >> FixedBits;
+                int iv = v >> FixedBits;
+                uint16_t wu = (uint16_t)((u >> (FixedBits - 8)) & 0xff);
+                uint16_t wv = (uint16_t)((v >> (FixedBits - 8)) & 0xff);
+
+                if ((unsigned)iu < (unsigned)(width - 1) && (unsigned)iv < (unsigned)(height - 1))
+                {
+                    // Inside, so all four are in the image
+                    const uint32_t *texel = image.GetPixels() + (size_t)iv * width + iu;
+                    inputs.mTopLeft[i] = texel[0];
+                    inputs.mTopRight[i] = texel[1];
+                    inputs.mBottomLeft[i] = texel[width];
+                    inputs.mBottomRight[i] = texel[width + 1];
+                }
+                else
+                {
+                    inputs.mTopLeft[i] = Texel(image, iu, iv);
+                    inputs.mTopRight[i] = Texel(image, iu + 1, iv);
+                    inputs.mBottomLeft[i] = Texel(image, iu, iv + 1);
+                    inputs.mBottomRight[i] = Texel(image, iu + 1, iv + 1);
+                }
+
+                for (int c = 0; c < 4; c++)
+                {
+                    inputs.mRightWeight[i * 4 + c] = wu;
+                    inputs.mBottomWeight[i * 4 + c] = wv;
+                }
+            }
+
+            Bilinear(row + x, inputs, count);
+        }
+    }
+}
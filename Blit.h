@@ -0,0 +1,19 @@
+/**
+ * @file Blit.h
+ * @author Noah Wolff
+ *
+ * Kernels that draw premultiplied images onto each other.
+ */
+
+#ifndef CANADIANEXPERIENCE_BLIT_H
+#define CANADIANEXPERIENCE_BLIT_H
+
+#include <cstdint>
+#include "Affine.h"
+class RenderImage;
+
+void BlitImage(const RenderImage &image, const Affine &transform, RenderImage &target);
+
+void BlendRow(uint32_t *dst, const uint32_t *src, int count);
+
+#endif //CANADIANEXPERIENCE_BLIT_H
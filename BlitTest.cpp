@@ -0,0 +1,149 @@
+/**
+ * @file BlitTest.cpp
+ * @author Noah Wolff
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <Blit.h>
+#include <RenderImage.h>
+#include <random>
+
+/**
+ * Fill an image with random premultiplied pixels
+ * @param image Image to fill
+ * @param seed Random number seed
+ */
+static void Randomize(RenderImage &image, int seed)
+{
+    std::mt19937 random(seed);
+    for (int i = 0; i < image.GetWidth() * image.GetHeight(); i++)
+    {
+        int alpha = random() % 256;
+        image.GetPixels()[i] = RenderImage::Pack(random() % (alpha + 1), random() % (alpha + 1),
+                random() % (alpha + 1), alpha);
+    }
+}
+
+/**
+ * One channel of a pixel
+ * @param pixel Pixel
+ * @param channel Channel, 0 for red to 3 for alpha
+ * @return Channel value
+ */
+static int Channel(uint32_t pixel, int channel)
+{
+    return (pixel >> (channel * 8)) & 0xff;
+}
+
+/**
+ * Put a premultiplied pixel over another the slow way
+ * @param dst Pixel underneath
+ * @param src Pixel on top
+ * @return Blended pixel
+ */
+static uint32_t Over(uint32_t dst, uint32_t src)
+{
+    int inverse = 255 - Channel(src, 3);
+    int result[4];
+    for (int c = 0; c < 4; c++)
+    {
+        result[c] = Channel(src, c) + (int)lround(Channel(dst, c) * inverse / 255.0);
+    }
+
+    return RenderImage::Pack(result[0], result[1], result[2], result[3]);
+}
+
+TEST(BlitTest, BlendRow)
+{
+    // Odd lengths so the vector code leaves some over
+    for (int count : {1, 2, 3, 7, 8, 9, 33})
+    {
+        RenderImage src(count, 1);
+        RenderImage dst(count, 1);
+        Randomize(src, count);
+        Randomize(dst, count + 100);
+
+        std::vector<uint32_t> expected(count);
+        for (int i = 0; i < count; i++)
+        {
+            expected[i] = Over(dst.GetPixel(i, 0), src.GetPixel(i, 0));
+        }
+
+        BlendRow(dst.GetPixels(), src.GetPixels(), count);
+        for (int i = 0; i < count; i++)
+        {
+            ASSERT_EQ(expected[i], dst.GetPixel(i, 0)) << "count " << count << " pixel " << i;
+        }
+    }
+}
+
+TEST(BlitTest, Aligned)
+{
+    RenderImage image(13, 5);
+    Randomize(image, 1);
+
+    RenderImage target(20, 10);
+    Randomize(target, 2);
+    RenderImage before(20, 10);
+    std::copy(target.GetPixels(), target.GetPixels() + 200, before.GetPixels());
+
+    // Partly off the right side
+    BlitImage(image, Affine::Translation(10, 3), target);
+    for (int y = 0; y < 10; y++)
+    {
+        for (int x = 0; x < 20; x++)
+        {
+            uint32_t expected = before.GetPixel(x, y);
+            if (x >= 10 && y >= 3 && y < 8)
+            {
+                expected = Over(expected, image.GetPixel(x - 10, y - 3));
+            }
+
+            ASSERT_EQ(expected, target.GetPixel(x, y)) << x << ", " << y;
+        }
+    }
+}
+
+TEST(BlitTest, HalfPixel)
+{
+    RenderImage image(11, 1);
+    Randomize(image, 3);
+
+    // Each target pixel is halfway between two image pixels
+    RenderImage target(16, 1);
+    BlitImage(image, Affine::Translation(2.5, 0), target);
+    for (int x = 0; x < 16; x++)
+    {
+        int left = x - 3;
+        uint32_t a = left >= 0 && left < 11 ? image.GetPixel(left, 0) : 0;
+        uint32_t b = left + 1 >= 0 && left + 1 < 11 ? image.GetPixel(left + 1, 0) : 0;
+        for (int c = 0; c < 4; c++)
+        {
+            int halfway = (Channel(a, c) * 128 + Channel(b, c) * 128 + 128) >> 8;
+            ASSERT_EQ(halfway, Channel(target.GetPixel(x, 0), c)) << x;
+        }
+    }
+}
+
+TEST(BlitTest, Rotated)
+{
+    RenderImage image(9, 6);
+    Randomize(image, 4);
+
+    // A quarter turn on whole pixels is an exact copy, with
+    // image column u on target row 11 - u and image row v on
+    // target column v + 4
+    RenderImage target(16, 16);
+    BlitImage(image, Affine::Translation(4, 12) * Affine::Rotation(M_PI / 2), target);
+    for (int y = 0; y < 16; y++)
+    {
+        for (int x = 0; x < 16; x++)
+        {
+            int u = 11 - y;
+            int v = x - 4;
+            uint32_t expected = u >= 0 && u < 9 && v >= 0 && v < 6 ? image.GetPixel(u, v) : 0;
+            ASSERT_EQ(expected, target.GetPixel(x, y)) << x << ", " << y;
+        }
+    }
+}
@@ -0,0 +1,260 @@
+/**
+ * @file CpuRenderer.cpp
+ * @author Noah Wolff
+ */
+
+#include "pch.h"
+#include "CpuRenderer.h"
+#include "Blit.h"
+
+/// Number of rows sampled in each pixel when filling polygons
+const int PolygonSamples = 4;
+
+/**
+ * Multiply two values in 0 to 255 as if they were fractions
+ * @param value Value
+ * @param scale Scale
+ * @return value * scale / 255, rounded
+ */
+static inline uint32_t Mul255(uint32_t value, uint32_t scale)
+{
+    uint32_t t = value * scale + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+/**
+ * Scale every channel of a premultiplied pixel
+ * @param pixel Pixel
+ * @param scale Scale, 0 to 255
+ * @return Scaled pixel
+ */
+static inline uint32_t Scale(uint32_t pixel, uint32_t scale)
+{
+    return Mul255(pixel & 0xff, scale) |
+            (Mul255((pixel >> 8) & 0xff, scale) << 8) |
+            (Mul255((pixel >> 16) & 0xff, scale) << 16) |
+            (Mul255(pixel >> 24, scale) << 24);
+}
+
+/**
+ * Put a premultiplied pixel over another
+ * @param dst Pixel underneath
+ * @param src Pixel on top
+ * @return Blended pixel
+ */
+static inline uint32_t Over(uint32_t dst, uint32_t src)
+{
+    return src + Scale(dst, 255 - (src >> 24));
+}
+
+/**
+ * Get a color as a premultiplied pixel
+ * @param color Color
+ * @return Pixel
+ */
+static uint32_t ToPixel(const wxColour &color)
+{
+    int a = color.Alpha();
+    return RenderImage::Pack(Mul255(color.Red(), a), Mul255(color.Green(), a), Mul255(color.Blue(), a), a);
+}
+
+/**
+ * Add the part of each pixel a horizontal span covers
+ * @param cover Coverage for each pixel in the row
+ * @param left Left end of the span, in pixels from the start of cover
+ * @param right Right end of the span
+ * @param weight Coverage of a fully covered pixel
+ */
+static void AddSpan(std::vector<float> &cover, double left, double right, float weight)
+{
+    int count = (int)cover.size();
+    left = std::max(left, 0.0);
+    right = std::min(right, (double)count);
+    if (right <= left)
+    {
+        return;
+    }
+
+    int first = (int)left;
+    int last = (int)right;
+    if (first == last)
+    {
+        cover[first] += float(right - left) * weight;
+        return;
+    }
+
+    cover[first] += float(first + 1 - left) * weight;
+    for (int x = first + 1; x < last; x++)
+    {
+        cover[x] += weight;
+    }
+
+    if (last < count)
+    {
+        cover[last] += float(right - last) * weight;
+    }
+}
+
+/**
+ * Constructor
+ * @param width Width in pixels
+ * @param height Height in pixels
+ */
+CpuRenderer::CpuRenderer(int width, int height) : mImage(width, height)
+{
+}
+
+/**
+ * Set every pixel to a color
+ * @param color Color
+ */
+void CpuRenderer::Clear(const wxColour &color)
+{
+    std::fill(mImage.GetPixels(), mImage.GetPixels() + (size_t)GetWidth() * GetHeight(), ToPixel(color));
+}
+
+/**
+ * Draw an image
+ *
+ * Each pixel we draw is mapped back into the image and
+ * sampled bilinearly, so rotated images are smooth and
+ * their edges are antialiased.
+ * @param image Image to draw, with its top left corner at (0, 0)
+ * @param transform Transformation from image pixels to the drawing
+ */
+void CpuRenderer::DrawImage(const RenderImage &image, const Affine &transform)
+{
+    BlitImage(image, transform, mImage);
+}
+
+/**
+ * Fill a polygon
+ *
+ * Uses the even-odd rule, like wxGraphicsContext does by default.
+ * @param points Corners of the polygon, the last is joined to the first
+ * @param color Color to fill with
+ * @param transform Transformation from the points to the drawing
+ */
+void CpuRenderer::FillPolygon(const std::vector<wxPoint2DDouble> &points, const wxColour &color,
+        const Affine &transform)
+{
+    int count = (int)points.size();
+    if (count < 3)
+    {
+        return;
+    }
+
+    // Corners in the drawing, with the first repeated at the end
+    std::vector<double> xs(count + 1);
+    std::vector<double> ys(count + 1);
+    double left = INFINITY;
+    double top = INFINITY;
+    double right = -INFINITY;
+    double bottom = -INFINITY;
+    for (int i = 0; i < count; i++)
+    {
+        auto p = transform.Apply(points[i]);
+        xs[i] = p.m_x;
+        ys[i] = p.m_y;
+        left = std::min(left, p.m_x);
+        top = std::min(top, p.m_y);
+        right = std::max(right, p.m_x);
+        bottom = std::max(bottom, p.m_y);
+    }
+
+    xs[count] = xs[0];
+    ys[count] = ys[0];
+
+    int x0 = std::max(0, (int)floor(left));
+    int y0 = std::max(0, (int)floor(top));
+    int x1 = std::min(GetWidth(), (int)ceil(right));
+    int y1 = std::min(GetHeight(), (int)ceil(bottom));
+    if (x1 <= x0 || y1 <= y0)
+    {
+        return;
+    }
+
+    uint32_t pixel = ToPixel(color);
+    uint32_t *pixels = mImage.GetPixels();
+    std::vector<float> cover(x1 - x0);
+    std::vector<double> crossings;
+    for (int y = y0; y < y1; y++)
+    {
+        std::fill(cover.begin(), cover.end(), 0.0f);
+        for (int s = 0; s < PolygonSamples; s++)
+        {
+            double sy = y + (s + 0.5) / PolygonSamples;
+            crossings.clear();
+            for (int i = 0; i < count; i++)
+            {
+                if ((ys[i] > sy) != (ys[i + 1] > sy))
+                {
+                    crossings.push_back(xs[i] + (sy - ys[i]) * (xs[i + 1] - xs[i]) / (ys[i + 1] - ys[i]));
+                }
+            }
+
+            std::sort(crossings.begin(), crossings.end());
+            for (size_t k = 0; k + 1 < crossings.size(); k += 2)
+            {
+                AddSpan(cover, crossings[k] - x0, crossings[k + 1] - x0, 1.0f / PolygonSamples);
+            }
+        }
+
+        uint32_t *row = pixels + (size_t)y * GetWidth() + x0;
+        for (int x = 0; x < x1 - x0; x++)
+        {
+            auto coverage = (uint32_t)lround(std::min(cover[x], 1.0f) * 255);
+            if (coverage != 0)
+            {
+                row[x] = Over(row[x], coverage == 255 ? pixel : Scale(pixel, coverage));
+            }
+        }
+    }
+}
+
+/**
+ * Draw a line through points
+ *
+ * Each segment is filled as a rectangle as wide as the line.
+ * @param points Points on the line
+ * @param closed true to join the last point to the first
+ * @param color Line color
+ * @param width Line width, in the same units as the points
+ * @param transform Transformation from the points to the drawing
+ */
+void CpuRenderer::StrokePolyline(const std::vector<wxPoint2DDouble> &points, bool closed,
+        const wxColour &color, double width, const Affine &transform)
+{
+    int count = (int)points.size();
+    if (count < 2)
+    {
+        return;
+    }
+
+    // Line width in the drawing
+    double half = width * sqrt(fabs(transform.GetA() * transform.GetD() - transform.GetB() * transform.GetC())) / 2;
+
+    Affine identity;
+    std::vector<wxPoint2DDouble> quad(4);
+    int segments = closed ? count : count - 1;
+    for (int i = 0; i < segments; i++)
+    {
+        auto p = transform.Apply(points[i]);
+        auto q = transform.Apply(points[(i + 1) % count]);
+        double dx = q.m_x - p.m_x;
+        double dy = q.m_y - p.m_y;
+        double length = sqrt(dx * dx + dy * dy);
+        if (length == 0)
+        {
+            continue;
+        }
+
+        double nx = -dy / length * half;
+        double ny = dx / length * half;
+        quad[0] = wxPoint2DDouble(p.m_x + nx, p.m_y + ny);
+        quad[1] = wxPoint2DDouble(q.m_x + nx, q.m_y + ny);
+        quad[2] = wxPoint2DDouble(q.m_x - nx, q.m_y - ny);
+        quad[3] = wxPoint2DDouble(p.m_x - nx, p.m_y - ny);
+        FillPolygon(quad, color, identity);
+    }
+}
@@ -0,0 +1,72 @@
+/**
+ * @file CpuRenderer.h
+ * @author Noah Wolff
+ *
+ * Renderer that draws into pixels in memory.
+ */
+
+#ifndef CANADIANEXPERIENCE_CPURENDERER_H
+#define CANADIANEXPERIENCE_CPURENDERER_H
+
+#include "Renderer.h"
+#include "RenderImage.h"
+
+
+/**
+ * Renderer that draws into pixels in memory.
+ *
+ * This needs no display and nothing from wxWidgets beyond the
+ * basic types, so it works on machines with no screen at all.
+ * The result is premultiplied RGBA in a RenderImage. Polygons are
+ * antialiased with a few samples in each pixel row and images are
+ * filtered bilinearly, so the result looks like the screen without
+ * depending on how any graphics library draws. The same drawing
+ * always gives exactly the same pixels.
+ */
+class CpuRenderer : public Renderer {
+private:
+    /// The pixels we draw into
+    RenderImage mImage;
+
+public:
+    CpuRenderer(int width, int height);
+
+    /// Default constructor (disabled)
+    CpuRenderer() = delete;
+
+    /// Copy constructor (disabled)
+    CpuRenderer(const CpuRenderer &) = delete;
+
+    /// Assignment operator
+    void operator=(const CpuRenderer &) = delete;
+
+    void Clear(const wxColour &color);
+
+    void DrawImage(const RenderImage &image, const Affine &transform) override;
+
+    void FillPolygon(const std::vector<wxPoint2DDouble> &points, const wxColour &color,
+            const Affine &transform) override;
+
+    void StrokePolyline(const std::vector<wxPoint2DDouble> &points, bool closed,
+            const wxColour &color, double width, const Affine &transform) override;
+
+    /**
+     * Get the pixels drawn so far
+     * @return Image we draw into
+     */
+    const RenderImage &GetImage() const { return mImage; }
+
+    /**
+     * Get the width
+     * @return Width in pixels
+     */
+    int GetWidth() const { return mImage.GetWidth(); }
+
+    /**
+     * Get the height
+     * @return Height in pixels
+     */
+    int GetHeight() const { return mImage.GetHeight(); }
+};
+
+#endif //CANADIANEXPERIENCE_CPURENDERER_H
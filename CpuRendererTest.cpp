@@ -0,0 +1,113 @@
+/**
+ * @file CpuRendererTest.cpp
+ * @author Noah Wolff
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <CpuRenderer.h>
+#include <PolyDrawable.h>
+#include <ImageDrawable.h>
+#include <Actor.h>
+#include <Picture.h>
+
+/// Get the alpha of a pixel
+static int Alpha(uint32_t pixel) { return pixel >> 24; }
+
+TEST(CpuRendererTest, Clear)
+{
+    CpuRenderer renderer(8, 4);
+    ASSERT_EQ(0u, renderer.GetImage().GetPixel(3, 2));
+
+    renderer.Clear(wxColour(255, 0, 0));
+    ASSERT_EQ(RenderImage::Pack(255, 0, 0, 255), renderer.GetImage().GetPixel(7, 3));
+
+    // Colors are premultiplied
+    renderer.Clear(wxColour(200, 100, 0, 128));
+    ASSERT_EQ(RenderImage::Pack(100, 50, 0, 128), renderer.GetImage().GetPixel(0, 0));
+}
+
+TEST(CpuRendererTest, FillPolygon)
+{
+    CpuRenderer renderer(20, 20);
+    std::vector<wxPoint2DDouble> square = {wxPoint2DDouble(0, 0), wxPoint2DDouble(4, 0),
+            wxPoint2DDouble(4, 4), wxPoint2DDouble(0, 4)};
+
+    // Placed on pixel boundaries, so the edges are sharp
+    renderer.FillPolygon(square, *wxBLACK, Affine::Translation(5, 6));
+    ASSERT_EQ(255, Alpha(renderer.GetImage().GetPixel(5, 6)));
+    ASSERT_EQ(255, Alpha(renderer.GetImage().GetPixel(8, 9)));
+    ASSERT_EQ(0, Alpha(renderer.GetImage().GetPixel(4, 6)));
+    ASSERT_EQ(0, Alpha(renderer.GetImage().GetPixel(9, 6)));
+    ASSERT_EQ(0, Alpha(renderer.GetImage().GetPixel(5, 10)));
+
+    // Half a pixel over, so the edge pixels are half covered
+    renderer.FillPolygon(square, *wxBLACK, Affine::Translation(12.5, 0));
+    ASSERT_EQ(128, Alpha(renderer.GetImage().GetPixel(12, 1)));
+    ASSERT_EQ(255, Alpha(renderer.GetImage().GetPixel(13, 1)));
+    ASSERT_EQ(128, Alpha(renderer.GetImage().GetPixel(16, 1)));
+
+    // Off the edges is clipped
+    renderer.FillPolygon(square, *wxBLACK, Affine::Translation(-2, 18));
+    ASSERT_EQ(255, Alpha(renderer.GetImage().GetPixel(0, 19)));
+}
+
+TEST(CpuRendererTest, DrawImage)
+{
+    RenderImage image(2, 2);
+    image.GetPixels()[0] = RenderImage::Pack(255, 0, 0, 255);
+    image.GetPixels()[1] = RenderImage::Pack(0, 255, 0, 255);
+    image.GetPixels()[2] = RenderImage::Pack(0, 0, 255, 255);
+    image.GetPixels()[3] = RenderImage::Pack(0, 0, 0, 128);
+
+    // On whole pixels the image is copied exactly
+    CpuRenderer renderer(6, 6);
+    renderer.DrawImage(image, Affine::Translation(3, 1));
+    ASSERT_EQ(image.GetPixel(0, 0), renderer.GetImage().GetPixel(3, 1));
+    ASSERT_EQ(image.GetPixel(1, 0), renderer.GetImage().GetPixel(4, 1));
+    ASSERT_EQ(image.GetPixel(0, 1), renderer.GetImage().GetPixel(3, 2));
+    ASSERT_EQ(image.GetPixel(1, 1), renderer.GetImage().GetPixel(4, 2));
+    ASSERT_EQ(0u, renderer.GetImage().GetPixel(2, 1));
+    ASSERT_EQ(0u, renderer.GetImage().GetPixel(5, 2));
+
+    // A quarter turn around the top left corner
+    CpuRenderer rotated(6, 6);
+    rotated.DrawImage(image, Affine::Translation(3, 3) * Affine::Rotation(M_PI / 2));
+    int opaque = 0;
+    for (int y = 0; y < 6; y++)
+    {
+        for (int x = 0; x < 6; x++)
+        {
+            opaque += Alpha(rotated.GetImage().GetPixel(x, y)) != 0;
+        }
+    }
+
+    ASSERT_EQ(4, opaque);
+}
+
+TEST(CpuRendererTest, RenderPicture)
+{
+    Picture picture;
+    auto actor = std::make_shared<Actor>(L"Actor");
+    auto poly = std::make_shared<PolyDrawable>(L"Poly");
+    poly->SetColor(wxColour(0, 0, 255));
+    poly->AddPoint(wxPoint(0, 0));
+    poly->AddPoint(wxPoint(10, 0));
+    poly->AddPoint(wxPoint(10, 10));
+    poly->AddPoint(wxPoint(0, 10));
+    actor->AddDrawable(poly);
+    actor->SetRoot(poly);
+    actor->SetPosition(wxPoint(20, 30));
+    picture.AddActor(actor);
+
+    CpuRenderer renderer(64, 64);
+    picture.Render(renderer);
+    ASSERT_EQ(RenderImage::Pack(0, 0, 255, 255), renderer.GetImage().GetPixel(25, 35));
+    ASSERT_EQ(0u, renderer.GetImage().GetPixel(15, 35));
+
+    // Disabled actors are not rendered
+    actor->SetEnabled(false);
+    CpuRenderer empty(64, 64);
+    picture.Render(empty);
+    ASSERT_EQ(0u, empty.GetImage().GetPixel(25, 35));
+}
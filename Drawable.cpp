@@ -7,6 +7,7 @@
 #include "Drawable.h"
 #include "Actor.h"
 #include "Timeline.h"
+#include "WxRenderer.h"
 
 
 /**
@@ -47,58 +48,174 @@ void Drawable::AddChild(std::shared_ptr<Drawable> child)
 {
     mChildren.push_back(child);
     child->SetParent(this);
+    child->MarkPlaceDirty();
+}
+
+/**
+ * Note that our position or rotation changed, so we and
+ * our descendants must be placed again.
+ *
+ * Our ancestors are flagged too, so Place can find us
+ * without visiting the parts of the tree that did not change.
+ */
+void Drawable::MarkPlaceDirty()
+{
+    mPlaceDirty = true;
+    for (auto ancestor = mParent; ancestor != nullptr; ancestor = ancestor->mParent)
+    {
+        ancestor->mChildPlaceDirty = true;
+    }
 }
 
 /**
  * Place this drawable relative to its parent
  *
- * This works hierarchically from top item down.
- * @param offset Parent offset
- * @param rotate Parent rotation
+ * This works hierarchically from top item down. The placed
+ * transform is only recomputed if our own position or rotation
+ * changed or we are given a different parent transform, and
+ * subtrees where nothing changed are not visited at all.
+ * @param parent Transformation from the parent to the drawing
  */
-void Drawable::Place(wxPoint offset, double rotate)
+void Drawable::Place(const Affine &parent)
 {
-    // Combine the transformation we are given with the transformation
-    // for this object.
-    mPlacedPosition = offset + RotatePoint(mPosition, rotate);
-    mPlacedRotation = mRotation + rotate;
+    if (mPlaceDirty || parent != mParentPlaced)
+    {
+        // Combine the transformation we are given with the transformation
+        // for this object.
+        SetPlaced(parent, parent * GetLocal());
+    }
+    else if (!mChildPlaceDirty)
+    {
+        // Nothing changed here or below
+        return;
+    }
 
-    // Update our children
-    for (auto drawable : mChildren)
+    // Update our children. A child whose transform has not changed
+    // and has no changes below it returns right away.
+    mChildPlaceDirty = false;
+    for (auto const &drawable : mChildren)
     {
-        drawable->Place(mPlacedPosition, mPlacedRotation);
+        drawable->Place(mPlaced);
     }
 }
 
+/**
+ * Get the transformation from this drawable to its parent
+ * @return Our position and rotation as a transformation
+ */
+Affine Drawable::GetLocal() const
+{
+    return Affine::Translation(mPosition.m_x, mPosition.m_y) * Affine::Rotation(mRotation);
+}
+
+/**
+ * Get the transformation from this drawable to its parent
+ * on a frame of the animation
+ *
+ * Like GetLocal, but with the rotation from the baked angle
+ * channel if it has keyframes.
+ * @param frame Frame, in [0, number of frames)
+ * @return Local transformation on the frame
+ */
+Affine Drawable::GetLocalAt(int frame) const
+{
+    double rotation = mChannel.IsValid() ? mChannel.GetBakedValue(frame) : mRotation;
+    return Affine::Translation(mPosition.m_x, mPosition.m_y) * Affine::Rotation(rotation);
+}
+
+/**
+ * Set where this drawable is placed, for when the placement
+ * has been computed somewhere other than Place
+ * @param parent Transformation from the parent to the drawing
+ * @param placed Transformation from this drawable to the drawing
+ */
+void Drawable::SetPlaced(const Affine &parent, const Affine &placed)
+{
+    mParentPlaced = parent;
+    mPlaced = placed;
+    mPlacedInverse = placed.Inverse();
+    mPlaceDirty = false;
+    mPlacedVersion++;
+}
+
+/**
+ * Get a box in the drawing around everything this
+ * drawable draws, where it was last placed
+ * @param bounds Set to the box
+ * @return false if the drawable draws nothing
+ */
+bool Drawable::GetBounds(wxRect &bounds)
+{
+    wxRect local;
+    if (!GetLocalBounds(local))
+    {
+        return false;
+    }
+
+    double left = INFINITY;
+    double top = INFINITY;
+    double right = -INFINITY;
+    double bottom = -INFINITY;
+    // The box covers whole pixels, so the far corner is one past the last pixel
+    double x1 = local.x;
+    double y1 = local.y;
+    double x2 = local.x + local.width;
+    double y2 = local.y + local.height;
+    for (auto corner : {wxPoint2DDouble(x1, y1), wxPoint2DDouble(x2, y1), wxPoint2DDouble(x1, y2), wxPoint2DDouble(x2, y2)})
+    {
+        auto p = mPlaced.Apply(corner);
+        left = std::min(left, p.m_x);
+        top = std::min(top, p.m_y);
+        right = std::max(right, p.m_x);
+        bottom = std::max(bottom, p.m_y);
+    }
+
+    bounds = wxRect(wxPoint((int)floor(left), (int)floor(top)), wxPoint((int)ceil(right), (int)ceil(bottom)));
+    return true;
+}
+
 /**
  * Move a Drawable
- * @param delta Angle to move
+ *
+ * The position is kept to a fraction of a pixel, so many
+ * small moves add up to the same thing as one big one.
+ * @param delta Distance to move in the drawing
  */
 void Drawable::Move(wxPoint delta)
 {
+    wxPoint2DDouble d(delta.x, delta.y);
     if (mParent != nullptr)
     {
-        mPosition = mPosition + RotatePoint(delta, -mParent->mPlacedRotation);
-    }
-    else
-    {
-        mPosition = mPosition + delta;
+        // Into the coordinates of the parent
+        d = mParent->mPlacedInverse.ApplyVector(d);
     }
+
+    SetPosition(mPosition + d);
 }
 
 /**
- * Rotate a point by a given angle.
- * @param point The point to rotate
- * @param angle An angle in radians
- * @return Rotated point
+ * Draw this drawable where it is placed
+ *
+ * This renders with a WxRenderer. Drawables that are drawn
+ * often can do better by keeping their own graphics objects.
+ * @param graphics Graphics object to draw on
  */
-wxPoint Drawable::RotatePoint(wxPoint point, double angle)
+void Drawable::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
-    double cosA = cos(angle);
-    double sinA = sin(angle);
+    WxRenderer renderer(graphics);
+    Render(renderer, mPlaced);
+}
 
-    return wxPoint(int(cosA * point.x + sinA * point.y),
-            int(-sinA * point.x + cosA * point.y));
+/**
+ * Concatenate the placed transformation onto a graphics
+ * context, so we can draw in our own coordinates
+ * @param graphics Graphics context to transform
+ */
+void Drawable::ConcatPlaced(std::shared_ptr<wxGraphicsContext> graphics)
+{
+    graphics->ConcatTransform(graphics->CreateMatrix(mPlaced.GetA(), mPlaced.GetB(),
+            mPlaced.GetC(), mPlaced.GetD(),
+            mPlaced.GetTranslation().m_x, mPlaced.GetTranslation().m_y));
 }
 
 /**
@@ -111,9 +228,13 @@ void Drawable::SetKeyframe()
 
 /**
  * Get a keyframe update from the animation system.
+ * @return true if the rotation changed
  */
-void Drawable::GetKeyframe()
+bool Drawable::GetKeyframe()
 {
-    if (mChannel.IsValid())
-        mRotation = mChannel.GetAngle();
+    if (!mChannel.IsValid() || mRotation == mChannel.GetAngle())
+        return false;
+
+    SetRotation(mChannel.GetAngle());
+    return true;
 }
@@ -12,7 +12,9 @@
 #define CANADIANEXPERIENCE_DRAWABLE_H
 
 #include "AnimChannelAngle.h"
+#include "Affine.h"
 class Actor;
+class Renderer;
 
 
 /**
@@ -26,8 +28,9 @@ private:
     /// Name of Drawable
     std::wstring mName;
 
-    /// X, Y position
-    wxPoint mPosition = wxPoint(0, 0);
+    /// X, Y position relative to the parent. Moving with
+    /// the mouse can leave this between pixels.
+    wxPoint2DDouble mPosition = wxPoint2DDouble(0, 0);
 
     /// Rotation
     double mRotation = 0;
@@ -44,17 +47,31 @@ private:
     /// The animation channel for animating the angle of this drawable
     AnimChannelAngle mChannel;
 
+    /// Parent transformation the placed transformation was computed from
+    Affine mParentPlaced;
+
+    /// Has our own position or rotation changed since we were placed?
+    bool mPlaceDirty = true;
+
+    /// Has the position or rotation of a descendant changed since we were placed?
+    bool mChildPlaceDirty = false;
+
+    /// Incremented every time we are placed somewhere new
+    int mPlacedVersion = 0;
+
+    void MarkPlaceDirty();
+
 protected:
-    /// The actual postion in the drawing
-    wxPoint mPlacedPosition = wxPoint(0, 0);
+    /// Transformation from this drawable to the drawing
+    Affine mPlaced;
 
-    /// The actual rotation in the drawing
-    double mPlacedRotation = 0;
+    /// Transformation from the drawing to this drawable
+    Affine mPlacedInverse;
 
     /// Constructor
     Drawable(const std::wstring &name);
 
-    wxPoint RotatePoint(wxPoint point, double angle);
+    void ConcatPlaced(std::shared_ptr<wxGraphicsContext> graphics);
 
 public:
     /// Default constructor (disabled)
@@ -77,19 +94,39 @@ public:
 
     void AddChild(std::shared_ptr<Drawable> child);
 
-    void Place(wxPoint offset, double rotate);
+    void Place(const Affine &parent);
+
+    Affine GetLocal() const;
+
+    Affine GetLocalAt(int frame) const;
+
+    void SetPlaced(const Affine &parent, const Affine &placed);
 
     void Move(wxPoint delta);
 
     void SetKeyframe();
 
-    void GetKeyframe();
+    bool GetKeyframe();
+
+    virtual void Draw(std::shared_ptr<wxGraphicsContext> graphics);
 
     /**
-     * Draw this drawable
-     * @param graphics Graphics object to draw on
+     * Render this drawable
+     *
+     * This can render a pose other than the one it is placed in.
+     * @param renderer Renderer to draw with
+     * @param placed Transformation from this drawable to the drawing
      */
-    virtual void Draw(std::shared_ptr<wxGraphicsContext> graphics) = 0;
+    virtual void Render(Renderer &renderer, const Affine &placed) const = 0;
+
+    /**
+     * Get ready to Render
+     *
+     * Drawables that need something made before they can be
+     * rendered override this. It is called on the thread that
+     * owns the picture, before any rendering.
+     */
+    virtual void PrepareRender() {}
 
     /**
      * Test to see if we have been clicked on by the mouse
@@ -98,6 +135,24 @@ public:
      */
     virtual bool HitTest(wxPoint pos) = 0;
 
+    /**
+     * Get a box around everything this drawable draws,
+     * in its own coordinates
+     *
+     * Drawables that can be clicked on must override this,
+     * since hit testing only looks inside the bounds.
+     * @param bounds Set to the box
+     * @return false if the drawable draws nothing
+     */
+    virtual bool GetLocalBounds(wxRect &bounds) { return false; }
+
+    bool GetBounds(wxRect &bounds);
+
+    /// Pixels drawing can reach outside of the bounds, for pen
+    /// widths and antialiasing. Anything that repaints or caches
+    /// an area from the bounds must grow it by this much.
+    static const int BoundsMargin = 2;
+
 
 
     /**
@@ -116,19 +171,39 @@ public:
      * Set the position
      * @param position Position value to set
      */
-    void SetPosition(wxPoint position) { mPosition = position; }
+    void SetPosition(wxPoint position) { SetPosition(wxPoint2DDouble(position.x, position.y)); }
+
+    /**
+     * Set the position to a point that may be between pixels
+     * @param position Position value to set
+     */
+    void SetPosition(const wxPoint2DDouble &position)
+    {
+        if (position != mPosition)
+        {
+            mPosition = position;
+            MarkPlaceDirty();
+        }
+    }
 
     /**
      * Get the position
      * @return Position of the Drawable
      */
-    wxPoint GetPosition() const { return mPosition; }
+    wxPoint GetPosition() const { return wxPoint((int)lround(mPosition.m_x), (int)lround(mPosition.m_y)); }
 
     /**
      * Set the rotation
      * @param rotation Rotation value to set
      */
-    void SetRotation(double rotation) { mRotation = rotation; }
+    void SetRotation(double rotation)
+    {
+        if (rotation != mRotation)
+        {
+            mRotation = rotation;
+            MarkPlaceDirty();
+        }
+    }
 
     /**
      * Get the rotation
@@ -136,6 +211,39 @@ public:
      */
     double GetRotation() { return mRotation; }
 
+    /**
+     * Get the transformation from this drawable to the
+     * drawing, as of the last time it was placed
+     * @return Placed transformation
+     */
+    const Affine &GetPlaced() const { return mPlaced; }
+
+    /**
+     * Get the transformation from the drawing to this drawable,
+     * for hit testing
+     * @return Inverse of the placed transformation
+     */
+    const Affine &GetPlacedInverse() const { return mPlacedInverse; }
+
+    /**
+     * Has our own position or rotation changed since we were placed?
+     * @return true if we must be placed again
+     */
+    bool IsPlaceDirty() const { return mPlaceDirty; }
+
+    /**
+     * Get a number that changes every time we are placed
+     * somewhere new, so others can tell if we moved
+     * @return Placement version
+     */
+    int GetPlacedVersion() const { return mPlacedVersion; }
+
+    /**
+     * Get the children of this drawable
+     * @return Child drawables
+     */
+    const std::vector<std::shared_ptr<Drawable>> &GetChildren() const { return mChildren; }
+
     /**
      * Set the child's parent Drawable
      * @param parent The parent Drawable
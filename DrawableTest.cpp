@@ -16,7 +16,7 @@ class DrawableMock : public Drawable
 public:
     DrawableMock(const std::wstring &name) : Drawable(name) {}
 
-    virtual void Draw(std::shared_ptr<wxGraphicsContext> graphics) override {}
+    virtual void Render(Renderer &renderer, const Affine &placed) const override {}
 
     virtual bool HitTest(wxPoint pos) override { return false; }
 };
@@ -77,6 +77,70 @@ TEST(DrawableTest, Association)
     ASSERT_EQ(&body, leg->GetParent());
 }
 
+/// Where a drawable is placed in the drawing
+static wxPoint2DDouble Placed(const Drawable &drawable)
+{
+    return drawable.GetPlaced().GetTranslation();
+}
+
+TEST(DrawableTest, Place)
+{
+    DrawableMock body(L"Body");
+    auto arm = std::make_shared<DrawableMock>(L"Arm");
+    auto hand = std::make_shared<DrawableMock>(L"Hand");
+    body.AddChild(arm);
+    arm->AddChild(hand);
+
+    arm->SetPosition(wxPoint(0, 100));
+    hand->SetPosition(wxPoint(0, 50));
+
+    auto offset = Affine::Translation(10, 20);
+    body.Place(offset);
+    ASSERT_EQ(wxPoint2DDouble(10, 170), Placed(*hand));
+
+    // Placing again with nothing changed leaves everything where it was
+    body.Place(offset);
+    ASSERT_EQ(wxPoint2DDouble(10, 170), Placed(*hand));
+
+    // A change deep in the tree is found from the root
+    hand->SetPosition(wxPoint(0, 60));
+    body.Place(offset);
+    ASSERT_EQ(wxPoint2DDouble(10, 180), Placed(*hand));
+
+    // Rotating an ancestor moves everything below it
+    arm->SetRotation(M_PI / 2);
+    body.Place(offset);
+    ASSERT_EQ(wxPoint2DDouble(10, 120), Placed(*arm));
+    ASSERT_NEAR(70, Placed(*hand).m_x, 0.00001);
+    ASSERT_NEAR(120, Placed(*hand).m_y, 0.00001);
+
+    // So does a different offset for the root
+    body.Place(Affine());
+    ASSERT_NEAR(60, Placed(*hand).m_x, 0.00001);
+    ASSERT_NEAR(100, Placed(*hand).m_y, 0.00001);
+}
+
+TEST(DrawableTest, Move)
+{
+    DrawableMock body(L"Body");
+    auto arm = std::make_shared<DrawableMock>(L"Arm");
+    body.AddChild(arm);
+
+    body.SetRotation(0.3);
+    body.Place(Affine());
+
+    // Many small moves under a rotated parent end up
+    // where one big move would
+    for (int i = 0; i < 100; i++)
+    {
+        arm->Move(wxPoint(1, 0));
+    }
+
+    body.Place(Affine());
+    ASSERT_NEAR(100, Placed(*arm).m_x, 0.00001);
+    ASSERT_NEAR(0, Placed(*arm).m_y, 0.00001);
+}
+
 TEST(ActorTest, SetPicture)
 {
     // Create a picture object
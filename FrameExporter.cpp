@@ -0,0 +1,146 @@
+/**
+ * @file FrameExporter.cpp
+ * @author Noah Wolff
+ */
+
+#include "pch.h"
+#include "FrameExporter.h"
+#include "Picture.h"
+#include "CpuRenderer.h"
+#include <atomic>
+#include <thread>
+
+/// Smallest number of digits in the frame number of a file name
+const size_t FrameDigits = 4;
+
+/**
+ * Constructor
+ * @param picture The picture to render
+ * @param numThreads Number of threads to render on,
+ * 0 for one for each core
+ */
+FrameExporter::FrameExporter(Picture *picture, int numThreads) :
+        mPicture(picture),
+        mThreadPool(numThreads > 0 ? numThreads : std::max(1, (int)std::thread::hardware_concurrency()))
+{
+}
+
+/**
+ * Get the picture ready to render frames
+ *
+ * RenderFrames calls this for you.
+ */
+void FrameExporter::Prepare()
+{
+    Prepare(*mPicture);
+}
+
+/**
+ * Get a picture ready to render frames
+ *
+ * This bakes every channel and prepares the drawables, so it
+ * must be called on the thread that owns the picture.
+ * @param picture Picture to prepare
+ */
+void FrameExporter::Prepare(Picture &picture)
+{
+    picture.GetTimeline()->Bake();
+    picture.PrepareRender();
+}
+
+/**
+ * Render one frame
+ *
+ * Call Prepare first. This only reads the picture.
+ * @param frame Frame, in [0, number of frames)
+ * @param renderer Renderer the size of the picture to draw with
+ */
+void FrameExporter::RenderFrame(int frame, CpuRenderer &renderer) const
+{
+    RenderFrame(*mPicture, frame, mBackground, renderer);
+}
+
+/**
+ * Render one frame of a picture
+ *
+ * Call Prepare on the picture first.
+ * @param picture Picture to render
+ * @param frame Frame, in [0, number of frames)
+ * @param background Color under everything
+ * @param renderer Renderer the size of the picture to draw with
+ */
+void FrameExporter::RenderFrame(const Picture &picture, int frame, const wxColour &background, CpuRenderer &renderer)
+{
+    renderer.Clear(background);
+    picture.RenderFrame(renderer, frame);
+}
+
+/**
+ * Render a range of frames on all of the threads
+ *
+ * Frames outside of the timeline are skipped. The frames are
+ * handed to done as they finish, which is not in order.
+ * @param first First frame
+ * @param last Last frame, inclusive
+ * @param done Called with each frame on the thread that rendered it
+ */
+void FrameExporter::RenderFrames(int first, int last, const FrameDone &done)
+{
+    first = std::max(first, 0);
+    last = std::min(last, mPicture->GetTimeline()->GetNumFrames() - 1);
+    if (last < first)
+    {
+        return;
+    }
+
+    Prepare();
+
+    auto size = mPicture->GetSize();
+    mThreadPool.ParallelFor(last - first + 1, 1, [this, first, size, &done](int begin, int end) {
+        CpuRenderer renderer(size.GetWidth(), size.GetHeight());
+        for (int i = begin; i < end; i++)
+        {
+            RenderFrame(first + i, renderer);
+            done(first + i, renderer.GetImage());
+        }
+    });
+}
+
+/**
+ * Render a range of frames to numbered PNG files
+ * @param directory Directory to put the files in
+ * @param prefix Start of each file name, before the frame number
+ * @param first First frame
+ * @param last Last frame, inclusive
+ * @return true if every file was written
+ */
+bool FrameExporter::ExportImages(const std::wstring &directory, const std::wstring &prefix, int first, int last)
+{
+    std::atomic<bool> ok(true);
+    RenderFrames(first, last, [&directory, &prefix, &ok](int frame, const RenderImage &image) {
+        if (!image.ToImage().SaveFile(GetFilename(directory, prefix, frame), wxBITMAP_TYPE_PNG))
+        {
+            ok = false;
+        }
+    });
+
+    return ok;
+}
+
+/**
+ * Get the name of the file a frame is exported to
+ * @param directory Directory the file is in
+ * @param prefix Start of the file name, before the frame number
+ * @param frame Frame
+ * @return Path to the file
+ */
+std::wstring FrameExporter::GetFilename(const std::wstring &directory, const std::wstring &prefix, int frame)
+{
+    auto number = std::to_wstring(frame);
+    if (number.size() < FrameDigits)
+    {
+        number.insert(0, FrameDigits - number.size(), L'0');
+    }
+
+    return directory + L"/" + prefix + number + L".png";
+}
@@ -0,0 +1,86 @@
+/**
+ * @file FrameExporter.h
+ * @author Noah Wolff
+ *
+ * Renders frames of a picture off the screen.
+ */
+
+#ifndef CANADIANEXPERIENCE_FRAMEEXPORTER_H
+#define CANADIANEXPERIENCE_FRAMEEXPORTER_H
+
+#include <functional>
+#include "ThreadPool.h"
+class Picture;
+class RenderImage;
+class CpuRenderer;
+
+
+/**
+ * Renders frames of a picture off the screen.
+ *
+ * Frames are rendered with the CPU renderer, so this needs no
+ * display. Every frame is posed from the baked channels on its
+ * own, nothing is shared between frames, so they can be rendered
+ * on as many threads as there are and in any order, and a frame
+ * always comes out exactly the same.
+ *
+ * This is safe because everything below RenderFrame only reads:
+ * Picture::RenderFrame, Actor::RenderFrame, Drawable::GetLocalAt,
+ * the drawables' Render, AnimChannelT::GetBakedValue and the
+ * RenderImages they draw. None of them changes the picture, so
+ * the picture must not be changed while frames are rendered.
+ */
+class FrameExporter {
+private:
+    /// The picture we render
+    Picture *mPicture;
+
+    /// Color under everything
+    wxColour mBackground = *wxWHITE;
+
+    /// Threads frames are rendered on
+    ThreadPool mThreadPool;
+
+public:
+    /// Called with each rendered frame, on the thread that rendered it
+    using FrameDone = std::function<void(int frame, const RenderImage &image)>;
+
+    FrameExporter(Picture *picture, int numThreads = 0);
+
+    /// Default constructor (disabled)
+    FrameExporter() = delete;
+
+    /// Copy constructor (disabled)
+    FrameExporter(const FrameExporter &) = delete;
+
+    /// Assignment operator
+    void operator=(const FrameExporter &) = delete;
+
+    void Prepare();
+
+    static void Prepare(Picture &picture);
+
+    void RenderFrame(int frame, CpuRenderer &renderer) const;
+
+    static void RenderFrame(const Picture &picture, int frame, const wxColour &background, CpuRenderer &renderer);
+
+    void RenderFrames(int first, int last, const FrameDone &done);
+
+    bool ExportImages(const std::wstring &directory, const std::wstring &prefix, int first, int last);
+
+    static std::wstring GetFilename(const std::wstring &directory, const std::wstring &prefix, int frame);
+
+    /**
+     * Set the color under everything
+     * @param background Background color
+     */
+    void SetBackground(const wxColour &background) { mBackground = background; }
+
+    /**
+     * Get the number of threads frames are rendered on
+     * @return Number of threads
+     */
+    int GetNumThreads() const { return mThreadPool.GetNumThreads(); }
+};
+
+#endif //CANADIANEXPERIENCE_FRAMEEXPORTER_H
@@ -0,0 +1,145 @@
+/**
+ * @file FrameExporterTest.cpp
+ * @author Noah Wolff
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <FrameExporter.h>
+#include <CpuRenderer.h>
+#include <Picture.h>
+#include <Actor.h>
+#include <PolyDrawable.h>
+#include <ImageDrawable.h>
+
+/**
+ * Make a picture with an animated actor in it
+ * @param picture Picture to add to
+ */
+static void MakeAnimation(Picture &picture)
+{
+    picture.SetSize(wxSize(120, 90));
+
+    auto actor = std::make_shared<Actor>(L"Actor");
+    auto body = std::make_shared<PolyDrawable>(L"Body");
+    body->SetColor(wxColour(200, 40, 40));
+    body->AddPoint(wxPoint(-10, -20));
+    body->AddPoint(wxPoint(10, -20));
+    body->AddPoint(wxPoint(12, 20));
+    body->AddPoint(wxPoint(-12, 20));
+    actor->AddDrawable(body);
+    actor->SetRoot(body);
+
+    // An image arm hanging off the body
+    wxImage image(8, 24);
+    image.InitAlpha();
+    for (int i = 0; i < 8 * 24; i++)
+    {
+        image.GetData()[i * 3] = (unsigned char)(i * 7);
+        image.GetData()[i * 3 + 1] = 90;
+        image.GetData()[i * 3 + 2] = (unsigned char)(255 - i);
+        image.GetAlpha()[i] = (unsigned char)(i % 5 == 0 ? 128 : 255);
+    }
+
+    auto arm = std::make_shared<ImageDrawable>(L"Arm", image);
+    arm->SetCenter(wxPoint(4, 2));
+    arm->SetPosition(wxPoint(10, -15));
+    actor->AddDrawable(arm);
+    body->AddChild(arm);
+
+    picture.AddActor(actor);
+
+    // Move and turn between keyframes
+    picture.SetAnimationFrame(0);
+    actor->SetPosition(wxPoint(30, 40));
+    arm->SetRotation(0);
+    actor->SetKeyframe();
+
+    picture.SetAnimationFrame(12);
+    actor->SetPosition(wxPoint(80, 50));
+    arm->SetRotation(1.2);
+    body->SetRotation(-0.3);
+    actor->SetKeyframe();
+
+    picture.SetAnimationFrame(25);
+    actor->SetPosition(wxPoint(60, 30));
+    arm->SetRotation(-0.7);
+    actor->SetKeyframe();
+
+    picture.GetTimeline()->SetInterpolation(12, 12, AnimChannel::Interpolation::CatmullRom);
+}
+
+/**
+ * Copy the pixels of an image
+ * @param image Image
+ * @return Pixels
+ */
+static std::vector<uint32_t> Pixels(const RenderImage &image)
+{
+    return std::vector<uint32_t>(image.GetPixels(), image.GetPixels() + image.GetWidth() * image.GetHeight());
+}
+
+TEST(FrameExporterTest, MatchesPicture)
+{
+    Picture picture;
+    MakeAnimation(picture);
+
+    FrameExporter exporter(&picture, 1);
+    exporter.Prepare();
+
+    // Posing a frame from the baked channels is the same as moving to it
+    for (int frame : {0, 5, 12, 19, 25, 40})
+    {
+        picture.SetAnimationFrame(frame);
+        CpuRenderer expected(120, 90);
+        expected.Clear(*wxWHITE);
+        picture.Render(expected);
+
+        CpuRenderer renderer(120, 90);
+        exporter.RenderFrame(frame, renderer);
+        ASSERT_EQ(Pixels(expected.GetImage()), Pixels(renderer.GetImage())) << "frame " << frame;
+    }
+}
+
+TEST(FrameExporterTest, ParallelMatchesSerial)
+{
+    Picture picture;
+    MakeAnimation(picture);
+
+    const int first = 3;
+    const int last = 30;
+    std::vector<std::vector<uint32_t>> serial(last + 1);
+    std::vector<std::vector<uint32_t>> parallel(last + 1);
+    std::vector<int> counts(last + 1, 0);
+
+    FrameExporter serialExporter(&picture, 1);
+    serialExporter.RenderFrames(first, last, [&serial](int frame, const RenderImage &image) {
+        serial[frame] = Pixels(image);
+    });
+
+    FrameExporter parallelExporter(&picture, 4);
+    ASSERT_EQ(4, parallelExporter.GetNumThreads());
+    parallelExporter.RenderFrames(first, last, [&parallel, &counts](int frame, const RenderImage &image) {
+        parallel[frame] = Pixels(image);
+        counts[frame]++;
+    });
+
+    for (int frame = first; frame <= last; frame++)
+    {
+        ASSERT_EQ(1, counts[frame]);
+        ASSERT_FALSE(serial[frame].empty());
+        ASSERT_EQ(serial[frame], parallel[frame]) << "frame " << frame;
+    }
+
+    // The actor moves, so the frames are not all the same
+    ASSERT_NE(serial[first], serial[last]);
+
+    // Frames outside the range were not rendered
+    ASSERT_EQ(0, counts[first - 1]);
+}
+
+TEST(FrameExporterTest, Filename)
+{
+    ASSERT_EQ(std::wstring(L"out/shot0007.png"), FrameExporter::GetFilename(L"out", L"shot", 7));
+    ASSERT_EQ(std::wstring(L"out/shot12345.png"), FrameExporter::GetFilename(L"out", L"shot", 12345));
+}
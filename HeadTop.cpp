@@ -5,6 +5,7 @@
 
 #include "pch.h"
 #include "HeadTop.h"
+#include "Renderer.h"
 
 /**
  * Constructor
@@ -15,98 +16,105 @@ HeadTop::HeadTop(const std::wstring &name, const std::wstring &filename) : Image
 {
 }
 
-/**
- * Transform a point from a location on the bitmap to
- * a location on the screen.
- * @param p Point to transform
- * @returns Transformed point
- */
-wxPoint HeadTop::TransformPoint(wxPoint p)
-{
-    // Make p relative to the image center
-    p = p - GetCenter();
+/// Width of an eye
+const double EyeWidth = 15;
 
-    // Rotate as needed and offset
-    return RotatePoint(p, mPlacedRotation) + mPlacedPosition;
-}
+/// Height of an eye
+const double EyeHeight = 20;
+
+/// Width of the eyebrow and eye outline lines
+const double FaceLineWidth = 2;
 
 /**
- * Draws the left eyebrow
- * @param graphics Graphics Context to draw on
+ * Pen for the eyebrows, shared by all heads
+ * @return Eyebrow pen
  */
-void HeadTop::LeftEyebrow(std::shared_ptr<wxGraphicsContext> graphics)
+static const wxPen &EyebrowPen()
 {
-    // Left eyebrow (offset to correct pos)
-    wxPoint p1 = TransformPoint(mEyeCenter + wxPoint(-25, -17));
-    wxPoint p2 = TransformPoint(mEyeCenter + wxPoint(-10, -20));
-    graphics->StrokeLine(p1.x, p1.y, p2.x, p2.y);
+    static const wxPen pen(*wxBLACK, (int)FaceLineWidth);
+    return pen;
 }
 
 /**
- * Draws the right eyebrow
- * @param graphics Graphics Context to draw on
+ * Brush for the eyes, shared by all heads
+ * @return Eye brush
  */
-void HeadTop::RightEyebrow(std::shared_ptr<wxGraphicsContext> graphics)
+static const wxBrush &EyeBrush()
 {
-    // Right eyebrow (offset to correct pos)
-    wxPoint p1 = TransformPoint(mEyeCenter + wxPoint(10, -20));
-    wxPoint p2 = TransformPoint(mEyeCenter + wxPoint(25, -17));
-    graphics->StrokeLine(p1.x, p1.y, p2.x, p2.y);
+    static const wxBrush brush(*wxBLACK);
+    return brush;
 }
 
 /**
- * Draws the left eye
- * @param graphics Graphics Context to draw on
- * @param wid Width to make the eye
- * @param hit Height to make the eye
+ * Build the eyebrow and eye paths in our own coordinates,
+ * relative to the image center
+ * @param graphics Graphics context to create the paths with
  */
-void HeadTop::LeftEye(std::shared_ptr<wxGraphicsContext> graphics, float wid, float hit)
+void HeadTop::BuildFace(std::shared_ptr<wxGraphicsContext> graphics)
 {
-    wxPoint e1 = TransformPoint( mEyeCenter + wxPoint(-17, 0)); //< offset the eye to correct pos
-    graphics->PushState();
-    graphics->Translate(e1.x, e1.y);
-    graphics->Rotate(-mPlacedRotation);
-    wxBrush brush(*wxBLACK);
-    graphics->SetBrush(brush);
-    graphics->DrawEllipse(-wid/2, -hit/2, wid, hit);
-    graphics->PopState();
+    mFaceCenter = GetCenter();
+    wxPoint eyes = mEyeCenter - mFaceCenter;
+
+    // Left and right eyebrows
+    mEyebrows = graphics->CreatePath();
+    mEyebrows.MoveToPoint(eyes.x - 25, eyes.y - 17);
+    mEyebrows.AddLineToPoint(eyes.x - 10, eyes.y - 20);
+    mEyebrows.MoveToPoint(eyes.x + 10, eyes.y - 20);
+    mEyebrows.AddLineToPoint(eyes.x + 25, eyes.y - 17);
+
+    // Left and right eyes
+    mEyes = graphics->CreatePath();
+    mEyes.AddEllipse(eyes.x - 17 - EyeWidth / 2, eyes.y - EyeHeight / 2, EyeWidth, EyeHeight);
+    mEyes.AddEllipse(eyes.x + 17 - EyeWidth / 2, eyes.y - EyeHeight / 2, EyeWidth, EyeHeight);
 }
 
 /**
- * Draws the right eye
- * @param graphics Graphics Context to draw on
- * @param wid Width to make the eye
- * @param hit Height to make the eye
+ * Draw this HeadTop
+ *
+ * The head image and the face are drawn under
+ * one placed transformation.
+ * @param graphics Graphics object to draw on
  */
-void HeadTop::RightEye(std::shared_ptr<wxGraphicsContext> graphics, float wid, float hit)
+void HeadTop::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
-    wxPoint e1 = TransformPoint(mEyeCenter + wxPoint(17, 0)); //< offset the eye to correct pos
+    if (mEyes.IsNull() || mFaceCenter != GetCenter())
+    {
+        BuildFace(graphics);
+    }
+
     graphics->PushState();
-    graphics->Translate(e1.x, e1.y);
-    graphics->Rotate(-mPlacedRotation);
-    wxBrush brush(*wxBLACK);
-    graphics->SetBrush(brush);
-    graphics->DrawEllipse(-wid/2, -hit/2, wid, hit);
+    ConcatPlaced(graphics);
+
+    DrawImage(graphics);
+
+    graphics->SetPen(EyebrowPen());
+    graphics->StrokePath(mEyebrows);
+
+    // Eyes are filled and outlined with the eyebrow pen
+    graphics->SetBrush(EyeBrush());
+    graphics->DrawPath(mEyes);
+
     graphics->PopState();
 }
 
 /**
- * Draw this HeadTop
- * @param graphics Graphics object to draw on
+ * Render this HeadTop
+ * @param renderer Renderer to draw with
+ * @param placed Transformation from this drawable to the drawing
  */
-void HeadTop::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void HeadTop::Render(Renderer &renderer, const Affine &placed) const
 {
-    ImageDrawable::Draw(graphics);
-    wxPen eyebrowPen(*wxBLACK, 2);
-    graphics->SetPen(eyebrowPen);
-
-    // Draw eyebrows
-    LeftEyebrow(graphics);
-    RightEyebrow(graphics);
-
-    // Draw eyes
-    float wid = 15.0f;
-    float hit = 20.0f;
-    LeftEye(graphics, wid, hit);
-    RightEye(graphics, wid, hit);
+    ImageDrawable::Render(renderer, placed);
+
+    wxPoint eyes = mEyeCenter - GetCenter();
+    renderer.StrokePolyline({wxPoint2DDouble(eyes.x - 25, eyes.y - 17), wxPoint2DDouble(eyes.x - 10, eyes.y - 20)},
+            false, *wxBLACK, FaceLineWidth, placed);
+    renderer.StrokePolyline({wxPoint2DDouble(eyes.x + 10, eyes.y - 20), wxPoint2DDouble(eyes.x + 25, eyes.y - 17)},
+            false, *wxBLACK, FaceLineWidth, placed);
+
+    for (double x : {eyes.x - 17 - EyeWidth / 2, eyes.x + 17 - EyeWidth / 2})
+    {
+        renderer.FillEllipse(x, eyes.y - EyeHeight / 2, EyeWidth, EyeHeight, *wxBLACK, placed);
+        renderer.StrokeEllipse(x, eyes.y - EyeHeight / 2, EyeWidth, EyeHeight, *wxBLACK, FaceLineWidth, placed);
+    }
 }
@@ -19,6 +19,17 @@ private:
     /// Center position for the eyes (default for harold)
     wxPoint mEyeCenter = wxPoint(55, 85);
 
+    /// The eyebrows, in our own coordinates
+    wxGraphicsPath mEyebrows;
+
+    /// The eyes, in our own coordinates
+    wxGraphicsPath mEyes;
+
+    /// Image center the face paths were built for
+    wxPoint mFaceCenter;
+
+    void BuildFace(std::shared_ptr<wxGraphicsContext> graphics);
+
 public:
     /// Default constructor (disabled)
     HeadTop() = delete;
@@ -34,17 +45,9 @@ public:
 
 
 
-    wxPoint TransformPoint(wxPoint p);
-
     void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
 
-    void LeftEyebrow(std::shared_ptr<wxGraphicsContext> graphics);
-
-    void RightEyebrow(std::shared_ptr<wxGraphicsContext> graphics);
-
-    void LeftEye(std::shared_ptr<wxGraphicsContext> graphics, float wid, float hit);
-
-    void RightEye(std::shared_ptr<wxGraphicsContext> graphics, float wid, float hit);
+    void Render(Renderer &renderer, const Affine &placed) const override;
 
 
 
@@ -58,7 +61,11 @@ public:
      * Set the eye center value for the HeadTop
      * @param eyeCenter Eye center point value to set
      */
-    void SetEyeCenter(wxPoint eyeCenter) { mEyeCenter = eyeCenter; }
+    void SetEyeCenter(wxPoint eyeCenter)
+    {
+        mEyeCenter = eyeCenter;
+        mEyes = wxGraphicsPath();
+    }
 
 };
 
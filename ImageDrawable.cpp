@@ -5,6 +5,7 @@
 
 #include "pch.h"
 #include "ImageDrawable.h"
+#include "Renderer.h"
 
 
 /**
@@ -13,9 +14,58 @@
  * @param filename The filename for the image
  */
 ImageDrawable::ImageDrawable(const std::wstring &name, const std::wstring &filename) :
-        Drawable(name)
+        Drawable(name), mFilename(filename)
 {
     mImage = std::make_unique<wxImage>(filename, wxBITMAP_TYPE_ANY);
+    BuildMask();
+}
+
+/**
+ * Constructor for an image already in memory
+ * @param name The drawable name
+ * @param image The image
+ */
+ImageDrawable::ImageDrawable(const std::wstring &name, const wxImage &image) :
+        Drawable(name)
+{
+    mImage = std::make_unique<wxImage>(image);
+    BuildMask();
+}
+
+/**
+ * Build the hit test mask from the image
+ *
+ * Apart from PrepareRender, this is the only place we look at the
+ * image pixels, so the image is not needed after the bitmap is created.
+ */
+void ImageDrawable::BuildMask()
+{
+    mWidth = mImage->IsOk() ? mImage->GetWidth() : 0;
+    mHeight = mImage->IsOk() ? mImage->GetHeight() : 0;
+    mMaskStride = (mWidth + 63) / 64;
+    mMask.assign(mMaskStride * mHeight, 0);
+
+    int left = mWidth;
+    int top = mHeight;
+    int right = -1;
+    int bottom = -1;
+    for (int y = 0; y < mHeight; y++)
+    {
+        uint64_t *row = &mMask[y * mMaskStride];
+        for (int x = 0; x < mWidth; x++)
+        {
+            if (!mImage->IsTransparent(x, y))
+            {
+                row[x / 64] |= uint64_t(1) << (x % 64);
+                left = std::min(left, x);
+                right = std::max(right, x);
+                top = std::min(top, y);
+                bottom = std::max(bottom, y);
+            }
+        }
+    }
+
+    mOpaque = right >= 0 ? wxRect(left, top, right - left + 1, bottom - top + 1) : wxRect();
 }
 
 /**
@@ -23,21 +73,89 @@ ImageDrawable::ImageDrawable(const std::wstring &name, const std::wstring &filen
  * @param graphics Graphics context to draw on
  */
 void ImageDrawable::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+{
+    graphics->PushState();
+    ConcatPlaced(graphics);
+    DrawImage(graphics);
+    graphics->PopState();
+}
+
+/**
+ * Render the image drawable
+ * @param renderer Renderer to draw with
+ * @param placed Transformation from this drawable to the drawing
+ */
+void ImageDrawable::Render(Renderer &renderer, const Affine &placed) const
+{
+    if (mRenderImage != nullptr)
+    {
+        renderer.DrawImage(*mRenderImage, placed * Affine::Translation(-mCenter.x, -mCenter.y));
+    }
+}
+
+/**
+ * Make the pixels the renderers draw
+ *
+ * Only drawables that are rendered pay for this copy of the
+ * pixels. If the editor has already released the image, it is
+ * loaded from the file again.
+ */
+void ImageDrawable::PrepareRender()
+{
+    if (mRenderImage != nullptr)
+    {
+        return;
+    }
+
+    if (mImage != nullptr)
+    {
+        mRenderImage = std::make_unique<RenderImage>(*mImage);
+    }
+    else
+    {
+        mRenderImage = std::make_unique<RenderImage>(wxImage(mFilename, wxBITMAP_TYPE_ANY));
+    }
+}
+
+/**
+ * Draw the image in our own coordinates
+ *
+ * The graphics context must already have the placed
+ * transformation on it.
+ * @param graphics Graphics context to draw on
+ */
+void ImageDrawable::DrawImage(std::shared_ptr<wxGraphicsContext> graphics)
 {
     if(mBitmap.IsNull())
     {
         mBitmap = graphics->CreateBitmapFromImage(*mImage);
-    }
 
-    graphics->PushState();
-    graphics->Translate(mPlacedPosition.x, mPlacedPosition.y);
-    graphics->Rotate(-mPlacedRotation);
-    graphics->DrawBitmap(mBitmap, -mCenter.x, -mCenter.y,
-            mImage->GetWidth(), mImage->GetHeight());
+        // The bitmap and the mask are all we need from now on,
+        // unless the image could not be loaded again
+        if (!mFilename.empty())
+        {
+            mImage.reset();
+        }
+    }
 
-    graphics->PopState();
+    graphics->DrawBitmap(mBitmap, -mCenter.x, -mCenter.y, mWidth, mHeight);
 }
 
+/**
+ * Get a box around the drawn part of the image in our own coordinates
+ * @param bounds Set to the box
+ * @return false if the image is entirely transparent
+ */
+bool ImageDrawable::GetLocalBounds(wxRect &bounds)
+{
+    if (mOpaque.IsEmpty())
+    {
+        return false;
+    }
+
+    bounds = wxRect(mOpaque.x - mCenter.x, mOpaque.y - mCenter.y, mOpaque.width, mOpaque.height);
+    return true;
+}
 
 /**
  * Test to see if we clicked on the image.
@@ -46,36 +164,17 @@ void ImageDrawable::Draw(std::shared_ptr<wxGraphicsContext> graphics)
  */
 bool ImageDrawable::HitTest(wxPoint pos)
 {
-    double x = pos.x;
-    double y = pos.y;
-
-    // Translate(-mPlacedPosition)
-    x -= mPlacedPosition.x;
-    y -= mPlacedPosition.y;
-
-    double sn = sin(mPlacedRotation);
-    double cs = cos(mPlacedRotation);
-
-    // Rotate(mPlacedR)
-    double x1 = cs * x - sn * y;
-    double y1 = sn * x + cs * y;
-
-    // Translate(mCenter)
-    x = x1 + mCenter.x;
-    y = y1 + mCenter.y;
-
-    double wid = mImage->GetWidth();
-    double hit = mImage->GetHeight();
+    // Into image pixels
+    auto local = GetPlacedInverse().Apply(pos);
+    int x = (int)floor(local.m_x + mCenter.x);
+    int y = (int)floor(local.m_y + mCenter.y);
 
-    // Test to see if x, y are in the image
-    if (x < 0 || y < 0 || x >= wid || y >= hit)
+    // Test to see if x, y are in the drawn part of the image.
+    // If the location is transparent, we are not in it.
+    if (!mOpaque.Contains(x, y))
     {
-        // We are outside the image
         return false;
     }
 
-    // Test to see if x, y are in the drawn part of the image
-    // If the location is transparent, we are not in the drawn
-    // part of the image
-    return !mImage->IsTransparent((int)x, (int)y);
+    return (mMask[y * mMaskStride + x / 64] >> (x % 64)) & 1;
 }
@@ -10,6 +10,8 @@
 
 #include "Drawable.h"
 #include "AnimChannelPos.h"
+#include "RenderImage.h"
+#include <cstdint>
 
 
 /**
@@ -21,9 +23,38 @@ class ImageDrawable : public Drawable {
 private:
     /// Center of image
     wxPoint mCenter = wxPoint(0,0);
-    
+
+    /// Image width in pixels
+    int mWidth = 0;
+
+    /// Image height in pixels
+    int mHeight = 0;
+
+    /// One bit per pixel, set where the image is not transparent.
+    /// Each row starts on a new word.
+    std::vector<uint64_t> mMask;
+
+    /// Number of words in a row of the mask
+    int mMaskStride = 0;
+
+    /// Box around the pixels that are not transparent,
+    /// in image pixels. Empty if there are none.
+    wxRect mOpaque;
+
+    /// File the image was loaded from, empty if it was given to us
+    std::wstring mFilename;
+
+    /// The image pixels for the renderers, made by PrepareRender
+    std::unique_ptr<RenderImage> mRenderImage;
+
+    void BuildMask();
+
 protected:
-    /// The image we are drawing
+    void DrawImage(std::shared_ptr<wxGraphicsContext> graphics);
+
+    /// The image we are drawing. This is released once the
+    /// graphics bitmap has been created from it, if it can
+    /// be loaded from the file again.
     std::unique_ptr<wxImage> mImage;
 
     /// The graphics bitmap we will use
@@ -35,6 +66,8 @@ public:
 
     /// New constructor
     ImageDrawable(const std::wstring &name, const std::wstring &filename);
+
+    ImageDrawable(const std::wstring &name, const wxImage &image);
     
     /// Copy constructor (disabled)
     ImageDrawable(const ImageDrawable &) = delete;
@@ -44,9 +77,15 @@ public:
 
 
 
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics);
+    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+
+    void Render(Renderer &renderer, const Affine &placed) const override;
+
+    void PrepareRender() override;
 
-    bool HitTest(wxPoint pos);
+    bool HitTest(wxPoint pos) override;
+
+    bool GetLocalBounds(wxRect &bounds) override;
 
 
 
@@ -54,7 +93,7 @@ public:
      * Get the center of the ImageDrawable
      * @return Center of the image
      */
-    wxPoint GetCenter() { return mCenter; }
+    wxPoint GetCenter() const { return mCenter; }
 
     /**
      * Set the center value of the ImageDrawable
@@ -62,6 +101,18 @@ public:
      */
     void SetCenter(wxPoint center) { mCenter = center; }
 
+    /**
+     * Get the image width
+     * @return Width in pixels
+     */
+    int GetWidth() const { return mWidth; }
+
+    /**
+     * Get the image height
+     * @return Height in pixels
+     */
+    int GetHeight() const { return mHeight; }
+
 };
 
 #endif //CANADIANEXPERIENCE_IMAGEDRAWABLE_H
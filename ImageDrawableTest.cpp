@@ -6,6 +6,7 @@
 #include <pch.h>
 #include "gtest/gtest.h"
 #include <ImageDrawable.h>
+#include <CpuRenderer.h>
 
 TEST(ImageDrawableTest, Center)
 {
@@ -20,3 +21,59 @@ TEST(ImageDrawableTest, Center)
     ASSERT_EQ(234, imageDrawable.GetCenter().x);
     ASSERT_EQ(569, imageDrawable.GetCenter().y);
 }
+
+TEST(ImageDrawableTest, HitTest)
+{
+    // A 100x50 image that is transparent except
+    // for a 20x10 block with its corner at 30, 5
+    wxImage image(100, 50);
+    image.InitAlpha();
+    for (int y = 0; y < 50; y++)
+    {
+        for (int x = 0; x < 100; x++)
+        {
+            bool opaque = x >= 30 && x < 50 && y >= 5 && y < 15;
+            image.GetAlpha()[y * 100 + x] = opaque ? 255 : 0;
+        }
+    }
+
+    ImageDrawable imageDrawable(L"Block", image);
+    imageDrawable.SetCenter(wxPoint(50, 25));
+    imageDrawable.Place(Affine::Translation(200, 100));
+
+    ASSERT_EQ(100, imageDrawable.GetWidth());
+    ASSERT_EQ(50, imageDrawable.GetHeight());
+
+    // Bounds are only around the opaque block
+    wxRect bounds;
+    ASSERT_TRUE(imageDrawable.GetBounds(bounds));
+    ASSERT_EQ(wxRect(180, 80, 21, 11), bounds);
+
+    ASSERT_TRUE(imageDrawable.HitTest(wxPoint(180, 80)));
+    ASSERT_TRUE(imageDrawable.HitTest(wxPoint(199, 89)));
+    ASSERT_FALSE(imageDrawable.HitTest(wxPoint(200, 89)));
+    ASSERT_FALSE(imageDrawable.HitTest(wxPoint(179, 85)));
+    ASSERT_FALSE(imageDrawable.HitTest(wxPoint(150, 75)));
+
+    // Turned upside down about the center
+    imageDrawable.SetRotation(M_PI);
+    imageDrawable.Place(Affine::Translation(200, 100));
+    ASSERT_TRUE(imageDrawable.HitTest(wxPoint(215, 115)));
+    ASSERT_FALSE(imageDrawable.HitTest(wxPoint(185, 85)));
+}
+
+TEST(ImageDrawableTest, PrepareRender)
+{
+    wxImage image(4, 4);
+    memset(image.GetData(), 200, 4 * 4 * 3);
+    ImageDrawable imageDrawable(L"Square", image);
+
+    // Nothing is rendered until the pixels are made
+    CpuRenderer renderer(4, 4);
+    imageDrawable.Render(renderer, Affine());
+    ASSERT_EQ(0u, renderer.GetImage().GetPixel(1, 1));
+
+    imageDrawable.PrepareRender();
+    imageDrawable.Render(renderer, Affine());
+    ASSERT_EQ(RenderImage::Pack(200, 200, 200, 255), renderer.GetImage().GetPixel(1, 1));
+}
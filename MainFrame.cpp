@@ -10,8 +10,15 @@
 #include "ViewTimeline.h"
 #include "Picture.h"
 #include "PictureFactory.h"
+#include "FrameExporter.h"
+#include "VideoExporter.h"
+#include "Y4mWriter.h"
+#include "RgbaWriter.h"
+#include "ApngWriter.h"
 #include <wx/xrc/xmlres.h>
 #include <wx/stdpaths.h>
+#include <wx/numdlg.h>
+#include <fstream>
 
 /// Directory within the resources that contains the images.
 const std::wstring ImagesDirectory = L"/images";
@@ -52,6 +59,8 @@ void MainFrame::Initialize()
     // Bind Menu Evevnt handlers
     Bind(wxEVT_COMMAND_MENU_SELECTED, &MainFrame::OnExit, this, wxID_EXIT);
     Bind(wxEVT_COMMAND_MENU_SELECTED, &MainFrame::OnAbout, this, wxID_ABOUT);
+    Bind(wxEVT_COMMAND_MENU_SELECTED, &MainFrame::OnExportFrames, this, XRCID("FileExportFrames"));
+    Bind(wxEVT_COMMAND_MENU_SELECTED, &MainFrame::OnExportVideo, this, XRCID("FileExportVideo"));
 
     // Create Edit and Timeline views
     mViewEdit = new ViewEdit(this);
@@ -90,3 +99,107 @@ void MainFrame::OnAbout(wxCommandEvent&event)
     wxXmlResource::Get()->LoadDialog(&aboutDlg, this, L"AboutDialog");
     aboutDlg.ShowModal();
 }
+
+/**
+ * File>Export Frames menu handler
+ *
+ * Renders a range of frames to numbered PNG
+ * files on all of the cores.
+ * @param event The menu event
+ */
+void MainFrame::OnExportFrames(wxCommandEvent& event)
+{
+    wxDirDialog dirDlg(this, L"Choose a directory for the frames");
+    if (dirDlg.ShowModal() != wxID_OK)
+    {
+        return;
+    }
+
+    int first, last;
+    if (!AskFrameRange(L"Export Frames", first, last))
+    {
+        return;
+    }
+
+    wxBusyCursor busy;
+    FrameExporter exporter(mPicture.get());
+    if (!exporter.ExportImages(dirDlg.GetPath().ToStdWstring(), L"frame", first, last))
+    {
+        wxMessageBox(L"Some of the frames could not be written.", L"Export Frames", wxOK | wxICON_ERROR, this);
+    }
+}
+
+/**
+ * File>Export Video menu handler
+ *
+ * Renders a range of frames straight into one video
+ * file, in whichever format the user picks.
+ * @param event The menu event
+ */
+void MainFrame::OnExportVideo(wxCommandEvent& event)
+{
+    wxFileDialog saveDlg(this, L"Export video", L"", L"",
+            L"Y4M video (*.y4m)|*.y4m|Raw RGBA video (*.rgba)|*.rgba|Animated PNG (*.png)|*.png",
+            wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+    if (saveDlg.ShowModal() != wxID_OK)
+    {
+        return;
+    }
+
+    int first, last;
+    if (!AskFrameRange(L"Export Video", first, last))
+    {
+        return;
+    }
+
+    std::ofstream out(saveDlg.GetPath().fn_str(), std::ios::binary);
+    std::unique_ptr<VideoWriter> writer;
+    switch (saveDlg.GetFilterIndex())
+    {
+    case 0:
+        writer = std::make_unique<Y4mWriter>(out);
+        break;
+
+    case 1:
+        writer = std::make_unique<RgbaWriter>(out);
+        break;
+
+    default:
+        writer = std::make_unique<ApngWriter>(out);
+        break;
+    }
+
+    wxBusyCursor busy;
+    VideoExporter exporter(mPicture.get());
+    if (!out.is_open() || !exporter.Export(*writer, first, last))
+    {
+        wxMessageBox(L"The video could not be written.", L"Export Video", wxOK | wxICON_ERROR, this);
+    }
+}
+
+/**
+ * Ask the user for a range of frames to export
+ * @param title Title for the dialog boxes
+ * @param first Set to the first frame
+ * @param last Set to the last frame, inclusive
+ * @return true if the user picked a range, false if they cancelled
+ */
+bool MainFrame::AskFrameRange(const wxString &title, int &first, int &last)
+{
+    long lastFrame = mPicture->GetTimeline()->GetNumFrames() - 1;
+    long firstFrame = wxGetNumberFromUser(L"First frame to export", L"First frame:", title, 0, 0, lastFrame, this);
+    if (firstFrame < 0)
+    {
+        return false;
+    }
+
+    lastFrame = wxGetNumberFromUser(L"Last frame to export", L"Last frame:", title, lastFrame, firstFrame, lastFrame, this);
+    if (lastFrame < 0)
+    {
+        return false;
+    }
+
+    first = (int)firstFrame;
+    last = (int)lastFrame;
+    return true;
+}
@@ -37,6 +37,12 @@ public:
     void OnExit(wxCommandEvent& event);
 
     void OnAbout(wxCommandEvent& event);
+
+    void OnExportFrames(wxCommandEvent& event);
+
+    void OnExportVideo(wxCommandEvent& event);
+
+    bool AskFrameRange(const wxString &title, int &first, int &last);
 };
 
 #endif //_MAINFRAME_H_
@@ -7,7 +7,12 @@
 #include "Picture.h"
 #include "PictureObserver.h"
 #include "Actor.h"
+#include "Drawable.h"
+#include <atomic>
+#include <cstring>
 
+/// Smallest number of actors worth giving to another thread
+const int MinActorChunk = 16;
 
 /**
  * Draw this picture on a device context
@@ -15,12 +20,149 @@
  */
 void Picture::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
-    for (auto actor : mActors)
+    int first = DrawLayer(graphics);
+    for (int i = first; i < (int)mActors.size(); i++)
     {
-        actor->Draw(graphics);
+        mActors[i]->Draw(graphics);
     }
 }
 
+/**
+ * Draw the part of this picture inside a rectangle
+ *
+ * Drawables entirely outside the rectangle are skipped. The
+ * caller should clip the graphics context to the rectangle.
+ * @param graphics The device context to draw on
+ * @param clip Area to draw, in picture coordinates
+ */
+void Picture::Draw(std::shared_ptr<wxGraphicsContext> graphics, const wxRect &clip)
+{
+    int first = DrawLayer(graphics);
+    for (int i = first; i < (int)mActors.size(); i++)
+    {
+        mActors[i]->Draw(graphics, clip);
+    }
+}
+
+/**
+ * Render this picture
+ *
+ * Unlike Draw, this uses no cached layers or sprites, so it works
+ * with any renderer and always gives the same result.
+ * @param renderer Renderer to draw with
+ */
+void Picture::Render(Renderer &renderer)
+{
+    for (auto const &actor : mActors)
+    {
+        actor->Render(renderer);
+    }
+}
+
+/**
+ * Get every drawable ready to render frames
+ */
+void Picture::PrepareRender()
+{
+    for (auto const &actor : mActors)
+    {
+        for (auto const &drawable : actor->GetDrawables())
+        {
+            drawable->PrepareRender();
+        }
+    }
+}
+
+/**
+ * Render this picture as it is on a frame of the animation
+ *
+ * The timeline must be baked and PrepareRender called first.
+ * @param renderer Renderer to draw with
+ * @param frame Frame, in [0, number of frames)
+ */
+void Picture::RenderFrame(Renderer &renderer, int frame) const
+{
+    for (auto const &actor : mActors)
+    {
+        actor->RenderFrame(renderer, frame);
+    }
+}
+
+/**
+ * Draw the actors at the back that are not animated from a cached layer
+ *
+ * The layer holds the longest run of actors, starting with the first,
+ * that have no keyframes that change anything and were not moved since
+ * the last draw. An actor that is being edited is left out until it
+ * stops changing, so dragging it does not draw the layer over and over.
+ * The layer is drawn again when any actor in it is edited, keyed, enabled
+ * or disabled, or the picture size changes.
+ * @param graphics The device context to draw on
+ * @return Number of actors drawn from the layer
+ */
+int Picture::DrawLayer(std::shared_ptr<wxGraphicsContext> graphics)
+{
+    // Every actor at the back is recorded, so the whole run is
+    // back in the layer on the first draw after an edit ends
+    std::vector<int> versions;
+    std::vector<int> last;
+    bool stable = true;
+    for (auto const &actor : mActors)
+    {
+        if (actor->IsAnimated())
+        {
+            break;
+        }
+
+        actor->Place();
+        int version = actor->IsEnabled() ? actor->GetPoseVersion() : -1;
+        int i = (int)last.size();
+        last.push_back(version);
+
+        if (i >= (int)mLastVersions.size() || mLastVersions[i] != version)
+        {
+            // Changed since the last draw, so it is being edited
+            stable = false;
+        }
+
+        if (stable)
+        {
+            versions.push_back(version);
+        }
+    }
+
+    mLastVersions.swap(last);
+    if (versions.empty())
+    {
+        return 0;
+    }
+
+    int width = mSize.GetWidth();
+    int height = mSize.GetHeight();
+    if (mLayer.IsNull() || versions != mLayerVersions || mLayerSize != mSize)
+    {
+        wxImage image(width, height);
+        image.InitAlpha();
+        memset(image.GetAlpha(), 0, (size_t)width * height);
+
+        {
+            auto layer = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create(image));
+            for (int i = 0; i < (int)versions.size(); i++)
+            {
+                mActors[i]->Draw(layer);
+            }
+        }
+
+        // The image holds the drawing once the context is gone
+        mLayer = graphics->CreateBitmapFromImage(image);
+        mLayerVersions = versions;
+        mLayerSize = mSize;
+    }
+
+    graphics->DrawBitmap(mLayer, 0, 0, width, height);
+    return (int)versions.size();
+}
+
 /**
  * Add an observer to this picture.
  * @param observer The observer to add
@@ -38,6 +180,80 @@ void Picture::AddActor(std::shared_ptr<Actor> actor)
 {
     mActors.push_back(actor);
     actor->SetPicture(this);
+    mIndexStale = true;
+}
+
+/**
+ * Find the front-most drawable under a point
+ *
+ * Only the drawables whose bounding boxes are near the point
+ * are tested, front to back, stopping at the first hit.
+ * @param pos Position in the picture
+ * @param actor Set to the actor the drawable belongs to
+ * @return The drawable hit or nullptr if none
+ */
+std::shared_ptr<Drawable> Picture::HitTest(wxPoint pos, std::shared_ptr<Actor> &actor)
+{
+    UpdateIndex();
+    return mIndex.HitTest(pos, actor);
+}
+
+/**
+ * Get the area of the picture that changed since the last
+ * call and must be repainted
+ *
+ * This is where the drawables that moved were and where
+ * they are now. The first call is the whole picture.
+ * @return Changed area in picture coordinates, empty if nothing changed
+ */
+wxRect Picture::TakeDamage()
+{
+    UpdateIndex();
+    wxRect damage = mIndex.TakeDamage();
+    if (mDamageAll)
+    {
+        mDamageAll = false;
+        return wxRect(0, 0, mSize.GetWidth(), mSize.GetHeight());
+    }
+
+    if (!damage.IsEmpty())
+    {
+        damage.Inflate(Drawable::BoundsMargin);
+    }
+
+    return damage;
+}
+
+/**
+ * Place the actors and bring the spatial index up to date
+ *
+ * Only what moved since the last update is placed
+ * again and moved to new cells. When the index is built again
+ * from scratch, the next TakeDamage is the whole picture.
+ */
+void Picture::UpdateIndex()
+{
+    if (mIndexStale)
+    {
+        mIndex.Clear();
+        for (auto const &actor : mActors)
+        {
+            for (auto const &drawable : actor->GetDrawables())
+            {
+                mIndex.Add(actor, drawable);
+            }
+        }
+
+        mIndexStale = false;
+        mDamageAll = true;
+    }
+
+    for (auto const &actor : mActors)
+    {
+        actor->Place();
+    }
+
+    mIndex.Refresh();
 }
 
 /**
@@ -55,9 +271,11 @@ void Picture::RemoveObserver(PictureObserver* observer)
 
 /**
  * Update all observers to indicate the picture has changed.
+ * @param poseChanged false if no actor changed, only the animation time
  */
-void Picture::UpdateObservers()
+void Picture::UpdateObservers(bool poseChanged)
 {
+    mPoseChanged = poseChanged;
     for (auto observer : mObservers)
     {
         observer->UpdateObserver();
@@ -74,11 +292,40 @@ void Picture::UpdateObservers()
 void Picture::SetAnimationTime(double time)
 {
     mTimeline.SetCurrentTime(time);
+    UpdateActors();
+}
 
-    for (auto actor : mActors)
-    {
-        actor->GetKeyframe();
-    }
+/**
+ * Set the current animation frame
+ *
+ * Like SetAnimationTime, but exactly on a frame. This
+ * is what playback and exporting use.
+ * @param frame The new frame.
+ */
+void Picture::SetAnimationFrame(int frame)
+{
+    mTimeline.EvaluateFrame(frame);
+    UpdateActors();
+}
+
+/**
+ * Update the actors from the animation channels
+ * and tell the observers.
+ */
+void Picture::UpdateActors()
+{
+    // Each actor only touches its own drawables, so the
+    // actors can be split across the timeline threads
+    std::atomic<bool> changed(false);
+    mTimeline.GetThreadPool()->ParallelFor((int)mActors.size(), MinActorChunk, [this, &changed](int begin, int end) {
+        for (int i = begin; i < end; i++)
+        {
+            if (mActors[i]->GetKeyframe())
+            {
+                changed = true;
+            }
+        }
+    });
 
-    UpdateObservers();
+    UpdateObservers(changed);
 }
@@ -14,8 +14,11 @@
 #include <vector>
 
 #include "Timeline.h"
+#include "SpatialIndex.h"
 class PictureObserver;
 class Actor;
+class Drawable;
+class Renderer;
 
 
 /**
@@ -38,6 +41,36 @@ private:
     /// The animation timeline
     Timeline mTimeline;
 
+    /// Did the last update change how the actors look?
+    bool mPoseChanged = true;
+
+    /// Where the drawables are, for hit testing
+    SpatialIndex mIndex;
+
+    /// Must the index be built again from the actors?
+    bool mIndexStale = true;
+
+    /// Was the index built again since the last TakeDamage?
+    bool mDamageAll = true;
+
+    /// Actors at the back that did not move are drawn once into this layer
+    wxGraphicsBitmap mLayer;
+
+    /// Picture size the layer was drawn at
+    wxSize mLayerSize;
+
+    /// Pose version of each actor drawn into the layer, -1 if disabled
+    std::vector<int> mLayerVersions;
+
+    /// Pose version of the actors at the back on the last draw
+    std::vector<int> mLastVersions;
+
+    void UpdateActors();
+
+    void UpdateIndex();
+
+    int DrawLayer(std::shared_ptr<wxGraphicsContext> graphics);
+
 public:
     /**
      * Constructor
@@ -54,16 +87,30 @@ public:
 
     void Draw(std::shared_ptr<wxGraphicsContext> graphics);
 
+    void Draw(std::shared_ptr<wxGraphicsContext> graphics, const wxRect &clip);
+
+    void Render(Renderer &renderer);
+
+    void RenderFrame(Renderer &renderer, int frame) const;
+
+    void PrepareRender();
+
     void AddObserver(PictureObserver *observer);
 
     void AddActor(std::shared_ptr<Actor> actor);
 
     void RemoveObserver(PictureObserver *observer);
 
-    void UpdateObservers();
+    void UpdateObservers(bool poseChanged = true);
 
     void SetAnimationTime(double time);
 
+    void SetAnimationFrame(int frame);
+
+    std::shared_ptr<Drawable> HitTest(wxPoint pos, std::shared_ptr<Actor> &actor);
+
+    wxRect TakeDamage();
+
 
 
     /**
@@ -78,6 +125,15 @@ public:
      */
     void SetSize(wxSize size) { mSize = size; }
 
+    /**
+     * Did the last observer update change how the actors look?
+     *
+     * False when only the animation time changed and no actor
+     * moved, so the picture does not need to be redrawn.
+     * @return true if the actors changed
+     */
+    bool IsPoseChanged() const { return mPoseChanged; }
+
     /**
      * Get the vector of observers
      * @return Vector of observer pointers
@@ -90,6 +146,12 @@ public:
      */
     Timeline *GetTimeline() { return &mTimeline; }
 
+    /**
+     * Build the spatial index again on the next update,
+     * after drawables were added to an actor in this picture
+     */
+    void InvalidateIndex() { mIndexStale = true; }
+
 
 
     //
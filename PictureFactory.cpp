@@ -35,6 +35,11 @@ std::shared_ptr<Picture> PictureFactory::Create(std::wstring imagesDir)
     HaroldFactory haroldFactory;
     auto harold = haroldFactory.Create(imagesDir);
 
+    // Place the rig from flat arrays, and draw from
+    // a sprite while not moving
+    harold->SetCompiled(true);
+    harold->SetSpriteCached(true);
+
     // This is where Harold will start out.
     harold->SetPosition(wxPoint(300, 500));
     picture->AddActor(harold);
@@ -43,6 +48,11 @@ std::shared_ptr<Picture> PictureFactory::Create(std::wstring imagesDir)
     LindaFactory lindaFactory;
     auto linda = lindaFactory.Create(imagesDir);
 
+    // Place the rig from flat arrays, and draw from
+    // a sprite while not moving
+    linda->SetCompiled(true);
+    linda->SetSpriteCached(true);
+
     // This is where Linda will start out.
     linda->SetPosition(wxPoint(725, 500));
     picture->AddActor(linda);
@@ -85,3 +85,21 @@ TEST(PictureTest, GetTimeline)
     Timeline *timeline = picture.GetTimeline();
     ASSERT_NE(nullptr, timeline);
 }
+
+TEST(PictureTest, DamageAfterHitTest)
+{
+    Picture picture;
+    picture.SetSize(wxSize(200, 100));
+
+    // The first damage is the whole picture, after that nothing moved
+    ASSERT_EQ(wxRect(0, 0, 200, 100), picture.TakeDamage());
+    ASSERT_TRUE(picture.TakeDamage().IsEmpty());
+
+    // A click after adding an actor rebuilds the index, but the
+    // new actor still has to be painted
+    picture.AddActor(make_shared<Actor>(L"Bob"));
+    shared_ptr<Actor> actor;
+    picture.HitTest(wxPoint(10, 10), actor);
+    ASSERT_EQ(wxRect(0, 0, 200, 100), picture.TakeDamage());
+    ASSERT_TRUE(picture.TakeDamage().IsEmpty());
+}
@@ -0,0 +1,97 @@
+/**
+ * @file Playback.cpp
+ * @author Noah Wolff
+ */
+
+#include "pch.h"
+#include "Playback.h"
+#include "Timeline.h"
+#include <chrono>
+
+
+/**
+ * Constructor
+ * @param timeline The timeline to play
+ */
+Playback::Playback(Timeline *timeline) : mTimeline(timeline)
+{
+}
+
+/**
+ * Get the current time from a monotonic clock
+ * @return Time in seconds from an arbitrary starting point
+ */
+double Playback::Now()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration<double>(now).count();
+}
+
+/**
+ * Start playing from the timeline's current frame
+ *
+ * If we are on the last frame and not looping, we start
+ * over from the first frame.
+ * @param now Clock time in seconds
+ */
+void Playback::Play(double now)
+{
+    mStartFrame = mTimeline->GetCurrentFrame();
+    if (mStartFrame < 0 || mStartFrame >= mTimeline->GetNumFrames() - 1)
+    {
+        mStartFrame = 0;
+    }
+
+    mStartTime = now;
+    mTicks = 0;
+    mFrame = mStartFrame;
+    mDroppedFrames = 0;
+    mPlaying = true;
+}
+
+/**
+ * Stop playing, staying on the current frame
+ */
+void Playback::Pause()
+{
+    mPlaying = false;
+}
+
+/**
+ * Determine the frame that should be shown now.
+ *
+ * When not looping, playback stops on the last frame.
+ * @param now Clock time in seconds
+ * @return Frame to show, or NoFrame if the frame already
+ * shown is still the right one or we are not playing
+ */
+int Playback::Update(double now)
+{
+    if (!mPlaying)
+    {
+        return NoFrame;
+    }
+
+    int ticks = (int)floor((now - mStartTime) * mTimeline->GetFrameRate());
+    if (ticks <= mTicks)
+    {
+        return NoFrame;
+    }
+
+    int numFrames = mTimeline->GetNumFrames();
+    int frame = mStartFrame + ticks;
+    int skipped = ticks - mTicks - 1;
+
+    if (!mLoop && frame >= numFrames - 1)
+    {
+        // Stop on the last frame. Only frames before it were skipped.
+        skipped = std::max(0, numFrames - 1 - (mStartFrame + mTicks) - 1);
+        frame = numFrames - 1;
+        mPlaying = false;
+    }
+
+    mDroppedFrames += skipped;
+    mTicks = ticks;
+    mFrame = frame % numFrames;
+    return mFrame;
+}
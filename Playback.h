@@ -0,0 +1,105 @@
+/**
+ * @file Playback.h
+ * @author Noah Wolff
+ *
+ * Real-time playback clock for a timeline.
+ */
+
+#ifndef CANADIANEXPERIENCE_PLAYBACK_H
+#define CANADIANEXPERIENCE_PLAYBACK_H
+
+class Timeline;
+
+
+/**
+ * Real-time playback clock for a timeline.
+ *
+ * Decides which frame should be on screen from a monotonic clock
+ * and the timeline frame rate. It does not evaluate or draw
+ * anything itself. The owner calls Update as often as it likes
+ * (from a timer) and shows the frame it returns. If the owner falls
+ * behind, frames are skipped rather than played late, so playback
+ * never drifts from real time, and the skipped frames are counted.
+ */
+class Playback {
+private:
+    /// The timeline we are playing
+    Timeline *mTimeline;
+
+    /// Are we playing?
+    bool mPlaying = false;
+
+    /// Do we start over when we reach the end?
+    bool mLoop = false;
+
+    /// Clock time playback started, in seconds
+    double mStartTime = 0;
+
+    /// Frame playback started on
+    int mStartFrame = 0;
+
+    /// Frames since the start frame of the last frame returned by Update
+    int mTicks = 0;
+
+    /// Last frame returned by Update
+    int mFrame = 0;
+
+    /// Frames skipped because Update was not called in time
+    int mDroppedFrames = 0;
+
+public:
+    /// Value Update returns when there is no new frame to show
+    static constexpr int NoFrame = -1;
+
+    Playback(Timeline *timeline);
+
+    /// Default constructor (disabled)
+    Playback() = delete;
+
+    /// Copy constructor (disabled)
+    Playback(const Playback &) = delete;
+
+    /// Assignment operator
+    void operator=(const Playback &) = delete;
+
+    static double Now();
+
+    void Play(double now);
+
+    void Pause();
+
+    int Update(double now);
+
+    /**
+     * Are we playing?
+     * @return true if playing
+     */
+    bool IsPlaying() const { return mPlaying; }
+
+    /**
+     * Do we start over when we reach the end?
+     * @return true if looping
+     */
+    bool IsLoop() const { return mLoop; }
+
+    /**
+     * Set whether we start over when we reach the end
+     * @param loop true to loop
+     */
+    void SetLoop(bool loop) { mLoop = loop; }
+
+    /**
+     * Get the last frame Update returned
+     * @return Frame number
+     */
+    int GetFrame() const { return mFrame; }
+
+    /**
+     * Get the number of frames skipped since Play
+     * because Update was not called in time
+     * @return Number of dropped frames
+     */
+    int GetDroppedFrames() const { return mDroppedFrames; }
+};
+
+#endif //CANADIANEXPERIENCE_PLAYBACK_H
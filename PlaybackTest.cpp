@@ -0,0 +1,60 @@
+/**
+ * @file PlaybackTest.cpp
+ * @author Noah Wolff
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <Playback.h>
+#include <Timeline.h>
+using namespace std;
+
+TEST(PlaybackTest, Construct)
+{
+    Timeline timeline;
+    Playback playback(&timeline);
+    ASSERT_FALSE(playback.IsPlaying());
+    ASSERT_EQ(Playback::NoFrame, playback.Update(100));
+}
+
+TEST(PlaybackTest, Frames)
+{
+    Timeline timeline;
+    Playback playback(&timeline);
+
+    // 30 frames per second, starting at a clock time of 100
+    playback.Play(100);
+    ASSERT_TRUE(playback.IsPlaying());
+
+    // Too soon for the next frame
+    ASSERT_EQ(Playback::NoFrame, playback.Update(100.01));
+
+    ASSERT_EQ(1, playback.Update(100 + 1.5 / 30));
+    ASSERT_EQ(2, playback.Update(100 + 2.5 / 30));
+    ASSERT_EQ(0, playback.GetDroppedFrames());
+
+    // We fell behind, so frames 3-5 are dropped rather than played late
+    ASSERT_EQ(6, playback.Update(100 + 6.5 / 30));
+    ASSERT_EQ(3, playback.GetDroppedFrames());
+
+    // Play stops on the last frame
+    ASSERT_EQ(299, playback.Update(200));
+    ASSERT_FALSE(playback.IsPlaying());
+    ASSERT_EQ(3 + 299 - 6 - 1, playback.GetDroppedFrames());
+}
+
+TEST(PlaybackTest, Loop)
+{
+    Timeline timeline;
+    timeline.SetNumFrames(10);
+
+    Playback playback(&timeline);
+    playback.SetLoop(true);
+    playback.Play(0);
+
+    ASSERT_EQ(9, playback.Update(9.5 / 30));
+    ASSERT_EQ(0, playback.Update(10.5 / 30));
+    ASSERT_EQ(3, playback.Update(13.5 / 30));
+    ASSERT_TRUE(playback.IsPlaying());
+    ASSERT_EQ(8 + 2, playback.GetDroppedFrames());
+}
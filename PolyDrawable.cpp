@@ -6,6 +6,7 @@
 #include "pch.h"
 #include "PolyDrawable.h"
 #include "Drawable.h"
+#include "Renderer.h"
 
 
 /**
@@ -18,34 +19,155 @@ PolyDrawable::PolyDrawable(const std::wstring &name) : Drawable(name)
 
 /**
  * Draw this Polygon
+ *
+ * The path is built once in our own coordinates and drawn
+ * with the placed transformation on the graphics context.
  * @param graphics Graphics object to draw on
  */
 void PolyDrawable::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
     if(!mPoints.empty()) {
-
-        mPath = graphics->CreatePath();
-        mPath.MoveToPoint(RotatePoint(mPoints[0], mPlacedRotation) + mPlacedPosition);
-        for (auto i = 1; i<mPoints.size(); i++)
+        if (mPath.IsNull())
         {
-            mPath.AddLineToPoint(RotatePoint(mPoints[i], mPlacedRotation) + mPlacedPosition);
+            mPath = graphics->CreatePath();
+            mPath.MoveToPoint(mPoints[0].x, mPoints[0].y);
+            for (auto i = 1; i<mPoints.size(); i++)
+            {
+                mPath.AddLineToPoint(mPoints[i].x, mPoints[i].y);
+            }
+            mPath.CloseSubpath();
         }
-        mPath.CloseSubpath();
 
-        wxBrush brush(mColor);
-        graphics->SetBrush(brush);
+        graphics->PushState();
+        ConcatPlaced(graphics);
+        graphics->SetBrush(mBrush);
         graphics->FillPath(mPath);
+        graphics->PopState();
+    }
+}
+
+/**
+ * Render this Polygon
+ * @param renderer Renderer to draw with
+ * @param placed Transformation from this drawable to the drawing
+ */
+void PolyDrawable::Render(Renderer &renderer, const Affine &placed) const
+{
+    std::vector<wxPoint2DDouble> points;
+    points.reserve(mPoints.size());
+    for (auto const &point : mPoints)
+    {
+        points.emplace_back(point.x, point.y);
+    }
+
+    renderer.FillPolygon(points, mColor, placed);
+}
+
+/**
+ * Compute where the points are in the drawing, if
+ * we have been placed somewhere new since the last time
+ */
+void PolyDrawable::UpdateWorld()
+{
+    if (mWorldVersion == GetPlacedVersion())
+    {
+        return;
+    }
+
+    mWorldVersion = GetPlacedVersion();
+
+    int count = (int)mPoints.size();
+    mWorldX.resize(count + 1);
+    mWorldY.resize(count + 1);
+
+    mWorldLeft = INFINITY;
+    mWorldTop = INFINITY;
+    mWorldRight = -INFINITY;
+    mWorldBottom = -INFINITY;
+    for (int i = 0; i < count; i++)
+    {
+        auto p = mPlaced.Apply(mPoints[i]);
+        mWorldX[i] = p.m_x;
+        mWorldY[i] = p.m_y;
+        mWorldLeft = std::min(mWorldLeft, p.m_x);
+        mWorldTop = std::min(mWorldTop, p.m_y);
+        mWorldRight = std::max(mWorldRight, p.m_x);
+        mWorldBottom = std::max(mWorldBottom, p.m_y);
+    }
+
+    if (count > 0)
+    {
+        mWorldX[count] = mWorldX[0];
+        mWorldY[count] = mWorldY[0];
     }
 }
 
 /**
  * Test to see if we have been clicked on by the mouse
+ *
+ * This only depends on where we are placed, not on
+ * anything being drawn.
  * @param pos Position to test
  * @return true if clicked on
  */
 bool PolyDrawable::HitTest(wxPoint pos)
 {
-    return mPath.Contains(pos.x, pos.y);
+    if (mPoints.size() < 3)
+    {
+        return false;
+    }
+
+    UpdateWorld();
+
+    double x = pos.x;
+    double y = pos.y;
+    if (x < mWorldLeft || x > mWorldRight || y < mWorldTop || y > mWorldBottom)
+    {
+        return false;
+    }
+
+    // Crossing number: count the edges a ray from the point to the
+    // right crosses. There are no branches in the loop, so the compiler
+    // can vectorize it. The division is only used when the edge
+    // straddles the ray, so it is never by zero when it matters.
+    const double *xs = mWorldX.data();
+    const double *ys = mWorldY.data();
+    int count = (int)mPoints.size();
+    int crossings = 0;
+    for (int i = 0; i < count; i++)
+    {
+        double x1 = xs[i];
+        double y1 = ys[i];
+        double x2 = xs[i + 1];
+        double y2 = ys[i + 1];
+
+        bool straddles = (y1 > y) != (y2 > y);
+        double crossX = x1 + (y - y1) * (x2 - x1) / (y2 - y1);
+        crossings += straddles & (x < crossX);
+    }
+
+    return (crossings & 1) != 0;
+}
+
+/**
+ * Get a box around the polygon in our own coordinates
+ * @param bounds Set to the box
+ * @return false if there are no points
+ */
+bool PolyDrawable::GetLocalBounds(wxRect &bounds)
+{
+    if (mPoints.empty())
+    {
+        return false;
+    }
+
+    bounds = wxRect(mPoints[0], mPoints[0]);
+    for (auto const &point : mPoints)
+    {
+        bounds = bounds.Union(wxRect(point, point));
+    }
+
+    return true;
 }
 
 /**
@@ -55,4 +177,6 @@ bool PolyDrawable::HitTest(wxPoint pos)
 void PolyDrawable::AddPoint(wxPoint point)
 {
     mPoints.push_back(point);
+    mWorldVersion = -1;
+    mPath = wxGraphicsPath();
 }
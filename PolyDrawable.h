@@ -23,13 +23,41 @@ private:
     /// The polygon color
     wxColour mColor = *wxBLACK;
 
+    /// Brush in the polygon color
+    wxBrush mBrush = wxBrush(*wxBLACK);
+
     /// The vector of point objects
     std::vector<wxPoint> mPoints;
 
-    /// The transformed graphics path used
-    /// to draw this polygon
+    /// The graphics path used to draw this polygon, in our
+    /// own coordinates. Null until it is first drawn.
     wxGraphicsPath mPath;
 
+    /// x of each point in the drawing, with the first
+    /// point repeated at the end to close the polygon
+    std::vector<double> mWorldX;
+
+    /// y of each point in the drawing, like mWorldX
+    std::vector<double> mWorldY;
+
+    /// Box around the points in the drawing
+    double mWorldLeft = 0;
+
+    /// Box around the points in the drawing
+    double mWorldTop = 0;
+
+    /// Box around the points in the drawing
+    double mWorldRight = 0;
+
+    /// Box around the points in the drawing
+    double mWorldBottom = 0;
+
+    /// Placement version the points in the drawing are for,
+    /// -1 if they must be computed again
+    int mWorldVersion = -1;
+
+    void UpdateWorld();
+
 public:
     /// Default constructor (disabled)
     PolyDrawable() = delete;
@@ -47,8 +75,12 @@ public:
 
     void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
 
+    void Render(Renderer &renderer, const Affine &placed) const override;
+
     bool HitTest(wxPoint pos) override;
 
+    bool GetLocalBounds(wxRect &bounds) override;
+
     void AddPoint(wxPoint point);
 
 
@@ -63,7 +95,11 @@ public:
      * Set the color
      * @param color Color to set
      */
-    void SetColor(wxColour color) { mColor = color; }
+    void SetColor(wxColour color)
+    {
+        mColor = color;
+        mBrush = wxBrush(color);
+    }
 
 };
 
@@ -166,3 +166,36 @@ TEST(PolyDrawableTest, Animation)
     ASSERT_NEAR(2.7 + 1.0 / 3.0 * (-1.8 - 2.7),
             drawable->GetRotation(), 0.00001);
 }
+
+TEST(PolyDrawableTest, HitTestWithoutDrawing)
+{
+    // An L shape, which is not convex
+    auto poly = std::make_shared<PolyDrawable>(L"L");
+    poly->AddPoint(wxPoint(0, 0));
+    poly->AddPoint(wxPoint(20, 0));
+    poly->AddPoint(wxPoint(20, 80));
+    poly->AddPoint(wxPoint(60, 80));
+    poly->AddPoint(wxPoint(60, 100));
+    poly->AddPoint(wxPoint(0, 100));
+
+    Actor actor(L"Actor");
+    actor.AddDrawable(poly);
+    actor.SetRoot(poly);
+    actor.SetPosition(wxPoint(100, 200));
+    actor.Place();
+
+    ASSERT_TRUE(poly->HitTest(wxPoint(110, 210)));
+    ASSERT_TRUE(poly->HitTest(wxPoint(150, 290)));
+
+    // In the bounding box, but in the notch of the L
+    ASSERT_FALSE(poly->HitTest(wxPoint(150, 220)));
+
+    // Outside the bounding box
+    ASSERT_FALSE(poly->HitTest(wxPoint(170, 290)));
+
+    // Moving is picked up without drawing
+    actor.SetPosition(wxPoint(0, 0));
+    actor.Place();
+    ASSERT_TRUE(poly->HitTest(wxPoint(10, 10)));
+    ASSERT_FALSE(poly->HitTest(wxPoint(110, 210)));
+}
@@ -0,0 +1,116 @@
+/**
+ * @file RenderImage.cpp
+ * @author Noah Wolff
+ */
+
+#include "pch.h"
+#include "RenderImage.h"
+
+/**
+ * Constructor, an image that is all transparent
+ * @param width Width in pixels
+ * @param height Height in pixels
+ */
+RenderImage::RenderImage(int width, int height) :
+        mWidth(width), mHeight(height), mPixels((size_t)width * height, 0)
+{
+}
+
+/**
+ * Constructor from a wxImage
+ *
+ * An image with no alpha channel is opaque except
+ * where its mask makes it transparent.
+ * @param image Image to copy
+ */
+RenderImage::RenderImage(const wxImage &image)
+{
+    if (!image.IsOk())
+    {
+        return;
+    }
+
+    mWidth = image.GetWidth();
+    mHeight = image.GetHeight();
+    mPixels.resize((size_t)mWidth * mHeight);
+
+    const unsigned char *rgb = image.GetData();
+    const unsigned char *alpha = image.HasAlpha() ? image.GetAlpha() : nullptr;
+    for (size_t i = 0; i < mPixels.size(); i++)
+    {
+        int a = 255;
+        if (alpha != nullptr)
+        {
+            a = alpha[i];
+        }
+        else if (image.HasMask() && image.IsTransparent(int(i % mWidth), int(i / mWidth)))
+        {
+            a = 0;
+        }
+
+        mPixels[i] = Pack((rgb[i * 3] * a + 127) / 255,
+                (rgb[i * 3 + 1] * a + 127) / 255,
+                (rgb[i * 3 + 2] * a + 127) / 255,
+                a);
+    }
+}
+
+/**
+ * Make a wxImage with alpha from this image
+ * @return The image, no longer premultiplied
+ */
+wxImage RenderImage::ToImage() const
+{
+    wxImage image(mWidth, mHeight, false);
+    image.InitAlpha();
+
+    unsigned char *rgb = image.GetData();
+    unsigned char *alpha = image.GetAlpha();
+    for (size_t i = 0; i < mPixels.size(); i++)
+    {
+        uint32_t pixel = Unpremultiply(mPixels[i]);
+        rgb[i * 3] = (unsigned char)pixel;
+        rgb[i * 3 + 1] = (unsigned char)(pixel >> 8);
+        rgb[i * 3 + 2] = (unsigned char)(pixel >> 16);
+        alpha[i] = (unsigned char)(pixel >> 24);
+    }
+
+    return image;
+}
+
+/**
+ * Make a pixel from its parts
+ * @param red Red, already premultiplied, 0 to 255
+ * @param green Green, already premultiplied, 0 to 255
+ * @param blue Blue, already premultiplied, 0 to 255
+ * @param alpha Alpha, 0 to 255
+ * @return Pixel
+ */
+uint32_t RenderImage::Pack(int red, int green, int blue, int alpha)
+{
+    return (uint32_t)red | ((uint32_t)green << 8) | ((uint32_t)blue << 16) | ((uint32_t)alpha << 24);
+}
+
+/**
+ * Undo the premultiplication of a pixel
+ * @param pixel Premultiplied pixel
+ * @return Pixel with the colors not multiplied by alpha,
+ * packed the same way
+ */
+uint32_t RenderImage::Unpremultiply(uint32_t pixel)
+{
+    int a = pixel >> 24;
+    if (a == 255 || a == 0)
+    {
+        return a == 0 ? 0 : pixel;
+    }
+
+    int rgb[3];
+    for (int c = 0; c < 3; c++)
+    {
+        int value = (pixel >> (c * 8)) & 0xff;
+        rgb[c] = std::min(255, (value * 255 + a / 2) / a);
+    }
+
+    return Pack(rgb[0], rgb[1], rgb[2], a);
+}
@@ -0,0 +1,87 @@
+/**
+ * @file RenderImage.h
+ * @author Noah Wolff
+ *
+ * An image as premultiplied RGBA pixels for the renderers.
+ */
+
+#ifndef CANADIANEXPERIENCE_RENDERIMAGE_H
+#define CANADIANEXPERIENCE_RENDERIMAGE_H
+
+#include <vector>
+#include <cstdint>
+
+
+/**
+ * An image as premultiplied RGBA pixels for the renderers.
+ *
+ * Each pixel is one 32 bit word holding red in the low byte, then
+ * green, blue and alpha, so in memory on a little-endian machine
+ * the bytes are R, G, B, A. The colors are premultiplied by alpha,
+ * which is what blending and filtering want.
+ */
+class RenderImage {
+private:
+    /// Width in pixels
+    int mWidth = 0;
+
+    /// Height in pixels
+    int mHeight = 0;
+
+    /// The pixels, row by row
+    std::vector<uint32_t> mPixels;
+
+public:
+    RenderImage(int width, int height);
+
+    RenderImage(const wxImage &image);
+
+    /// Default constructor (disabled)
+    RenderImage() = delete;
+
+    /// Copy constructor (disabled)
+    RenderImage(const RenderImage &) = delete;
+
+    /// Assignment operator
+    void operator=(const RenderImage &) = delete;
+
+    wxImage ToImage() const;
+
+    static uint32_t Pack(int red, int green, int blue, int alpha);
+
+    static uint32_t Unpremultiply(uint32_t pixel);
+
+    /**
+     * Get the width
+     * @return Width in pixels
+     */
+    int GetWidth() const { return mWidth; }
+
+    /**
+     * Get the height
+     * @return Height in pixels
+     */
+    int GetHeight() const { return mHeight; }
+
+    /**
+     * Get a pixel
+     * @param x Column, must be in the image
+     * @param y Row, must be in the image
+     * @return Premultiplied pixel
+     */
+    uint32_t GetPixel(int x, int y) const { return mPixels[y * mWidth + x]; }
+
+    /**
+     * Get the pixels
+     * @return Pointer to the first pixel of the first row
+     */
+    const uint32_t *GetPixels() const { return mPixels.data(); }
+
+    /**
+     * Get the pixels to change them
+     * @return Pointer to the first pixel of the first row
+     */
+    uint32_t *GetPixels() { return mPixels.data(); }
+};
+
+#endif //CANADIANEXPERIENCE_RENDERIMAGE_H
@@ -0,0 +1,66 @@
+/**
+ * @file Renderer.cpp
+ * @author Noah Wolff
+ */
+
+#include "pch.h"
+#include "Renderer.h"
+
+/// Number of corners used for an ellipse
+const int EllipseSegments = 48;
+
+/**
+ * Get points around an ellipse
+ * @param x Left of the box around the ellipse
+ * @param y Top of the box around the ellipse
+ * @param width Width of the box
+ * @param height Height of the box
+ * @return Points around the ellipse
+ */
+std::vector<wxPoint2DDouble> Renderer::EllipsePoints(double x, double y, double width, double height)
+{
+    double rx = width / 2;
+    double ry = height / 2;
+    double cx = x + rx;
+    double cy = y + ry;
+
+    std::vector<wxPoint2DDouble> points(EllipseSegments);
+    for (int i = 0; i < EllipseSegments; i++)
+    {
+        double angle = 2 * M_PI * i / EllipseSegments;
+        points[i] = wxPoint2DDouble(cx + rx * cos(angle), cy + ry * sin(angle));
+    }
+
+    return points;
+}
+
+/**
+ * Fill an ellipse
+ * @param x Left of the box around the ellipse
+ * @param y Top of the box around the ellipse
+ * @param width Width of the box
+ * @param height Height of the box
+ * @param color Color to fill with
+ * @param transform Transformation from the box to the drawing
+ */
+void Renderer::FillEllipse(double x, double y, double width, double height,
+        const wxColour &color, const Affine &transform)
+{
+    FillPolygon(EllipsePoints(x, y, width, height), color, transform);
+}
+
+/**
+ * Draw the outline of an ellipse
+ * @param x Left of the box around the ellipse
+ * @param y Top of the box around the ellipse
+ * @param width Width of the box
+ * @param height Height of the box
+ * @param color Line color
+ * @param lineWidth Line width
+ * @param transform Transformation from the box to the drawing
+ */
+void Renderer::StrokeEllipse(double x, double y, double width, double height,
+        const wxColour &color, double lineWidth, const Affine &transform)
+{
+    StrokePolyline(EllipsePoints(x, y, width, height), true, color, lineWidth, transform);
+}
@@ -0,0 +1,75 @@
+/**
+ * @file Renderer.h
+ * @author Noah Wolff
+ *
+ * Base class for the things drawables can be rendered with.
+ */
+
+#ifndef CANADIANEXPERIENCE_RENDERER_H
+#define CANADIANEXPERIENCE_RENDERER_H
+
+#include <vector>
+#include "Affine.h"
+class RenderImage;
+
+
+/**
+ * Base class for the things drawables can be rendered with.
+ *
+ * A renderer only knows a few shapes. Everything is given in the
+ * coordinates of the drawable with the transformation from those
+ * coordinates to the drawing, so a renderer never needs to know
+ * where a drawable is placed.
+ */
+class Renderer {
+public:
+    /// Copy constructor (disabled)
+    Renderer(const Renderer &) = delete;
+
+    /// Assignment operator
+    void operator=(const Renderer &) = delete;
+
+    /// Virtual destructor
+    virtual ~Renderer() {}
+
+    /**
+     * Draw an image
+     * @param image Image to draw, with its top left corner at (0, 0)
+     * @param transform Transformation from image pixels to the drawing
+     */
+    virtual void DrawImage(const RenderImage &image, const Affine &transform) = 0;
+
+    /**
+     * Fill a polygon
+     * @param points Corners of the polygon, the last is joined to the first
+     * @param color Color to fill with
+     * @param transform Transformation from the points to the drawing
+     */
+    virtual void FillPolygon(const std::vector<wxPoint2DDouble> &points, const wxColour &color,
+            const Affine &transform) = 0;
+
+    /**
+     * Draw a line through points
+     * @param points Points on the line
+     * @param closed true to join the last point to the first
+     * @param color Line color
+     * @param width Line width, in the same units as the points
+     * @param transform Transformation from the points to the drawing
+     */
+    virtual void StrokePolyline(const std::vector<wxPoint2DDouble> &points, bool closed,
+            const wxColour &color, double width, const Affine &transform) = 0;
+
+    void FillEllipse(double x, double y, double width, double height,
+            const wxColour &color, const Affine &transform);
+
+    void StrokeEllipse(double x, double y, double width, double height,
+            const wxColour &color, double lineWidth, const Affine &transform);
+
+    static std::vector<wxPoint2DDouble> EllipsePoints(double x, double y, double width, double height);
+
+protected:
+    /// Constructor
+    Renderer() {}
+};
+
+#endif //CANADIANEXPERIENCE_RENDERER_H
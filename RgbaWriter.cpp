@@ -0,0 +1,45 @@
+/**
+ * @file RgbaWriter.cpp
+ * @author Noah Wolff
+ */
+
+#include "pch.h"
+#include "RgbaWriter.h"
+#include "RenderImage.h"
+
+/**
+ * Constructor
+ * @param out Stream to write to, opened in binary mode
+ */
+RgbaWriter::RgbaWriter(std::ostream &out) : VideoWriter(out)
+{
+}
+
+/**
+ * Write the next frame
+ * @param image Frame, the size given to Begin
+ * @return true if the stream is still good
+ */
+bool RgbaWriter::WriteFrame(const RenderImage &image)
+{
+    int width = image.GetWidth();
+    mRow.resize((size_t)width * 4);
+
+    const uint32_t *pixels = image.GetPixels();
+    for (int y = 0; y < image.GetHeight(); y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            uint32_t pixel = RenderImage::Unpremultiply(pixels[x]);
+            for (int c = 0; c < 4; c++)
+            {
+                mRow[x * 4 + c] = (unsigned char)(pixel >> (c * 8));
+            }
+        }
+
+        Write(mRow.data(), mRow.size());
+        pixels += width;
+    }
+
+    return GetStream().good();
+}
@@ -0,0 +1,34 @@
+/**
+ * @file RgbaWriter.h
+ * @author Noah Wolff
+ *
+ * Writes frames as raw RGBA video.
+ */
+
+#ifndef CANADIANEXPERIENCE_RGBAWRITER_H
+#define CANADIANEXPERIENCE_RGBAWRITER_H
+
+#include <vector>
+#include "VideoWriter.h"
+
+
+/**
+ * Writes frames as raw RGBA video.
+ *
+ * There is no header, just the frames one after another, each
+ * row by row with four bytes in each pixel, not premultiplied.
+ * Encoders need to be told the size, frame rate and pixel
+ * format, as with ffmpeg -f rawvideo -pix_fmt rgba.
+ */
+class RgbaWriter : public VideoWriter {
+private:
+    /// One row of bytes, reused for every row
+    std::vector<unsigned char> mRow;
+
+public:
+    RgbaWriter(std::ostream &out);
+
+    bool WriteFrame(const RenderImage &image) override;
+};
+
+#endif //CANADIANEXPERIENCE_RGBAWRITER_H
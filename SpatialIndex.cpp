@@ -0,0 +1,196 @@
+/**
+ * @file SpatialIndex.cpp
+ * @author Noah Wolff
+ */
+
+#include "pch.h"
+#include "SpatialIndex.h"
+#include "Actor.h"
+#include "Drawable.h"
+#include <algorithm>
+
+
+/**
+ * Constructor
+ * @param cellSize Width and height of a grid cell in pixels
+ */
+SpatialIndex::SpatialIndex(int cellSize) : mCellSize(cellSize)
+{
+}
+
+/**
+ * Remove all of the drawables
+ */
+void SpatialIndex::Clear()
+{
+    mEntries.clear();
+    mCells.clear();
+    mDamage = wxRect();
+}
+
+/**
+ * Add a drawable in front of the ones already added
+ *
+ * It is put in the cells the next time we Refresh.
+ * @param actor The actor the drawable belongs to
+ * @param drawable The drawable
+ */
+void SpatialIndex::Add(std::shared_ptr<Actor> actor, std::shared_ptr<Drawable> drawable)
+{
+    Entry entry;
+    entry.mActor = actor;
+    entry.mDrawable = drawable;
+    mEntries.push_back(entry);
+}
+
+/**
+ * Move the drawables that were placed again since
+ * the last refresh to the cells they are in now
+ */
+void SpatialIndex::Refresh()
+{
+    for (int i = 0; i < (int)mEntries.size(); i++)
+    {
+        auto &entry = mEntries[i];
+        int version = entry.mDrawable->GetPlacedVersion();
+        if (version == entry.mPlacedVersion)
+        {
+            continue;
+        }
+
+        // Where it was and where it is now both need repainting
+        if (!entry.mEmpty)
+        {
+            mDamage = mDamage.Union(entry.mBounds);
+        }
+
+        RemoveFromCells(i);
+        entry.mPlacedVersion = version;
+        entry.mEmpty = !entry.mDrawable->GetBounds(entry.mBounds);
+        AddToCells(i);
+
+        if (!entry.mEmpty)
+        {
+            mDamage = mDamage.Union(entry.mBounds);
+        }
+    }
+}
+
+/**
+ * Get the area that changed because drawables moved and start
+ * collecting again
+ *
+ * The area is the union of the old and new bounds of every
+ * drawable that Refresh found had moved since the last call.
+ * @return Changed area, empty if nothing moved
+ */
+wxRect SpatialIndex::TakeDamage()
+{
+    wxRect damage = mDamage;
+    mDamage = wxRect();
+    return damage;
+}
+
+/**
+ * Find the front-most drawable under a point
+ *
+ * Drawables of actors that are disabled or not clickable are
+ * skipped. Call Refresh first if anything has moved.
+ * @param pos Position in the drawing
+ * @param actor Set to the actor the drawable belongs to
+ * @return The drawable hit or nullptr if none
+ */
+std::shared_ptr<Drawable> SpatialIndex::HitTest(wxPoint pos, std::shared_ptr<Actor> &actor) const
+{
+    auto cell = mCells.find(CellKey(Cell(pos.x), Cell(pos.y)));
+    if (cell == mCells.end())
+    {
+        return nullptr;
+    }
+
+    for (int i : cell->second)
+    {
+        auto const &entry = mEntries[i];
+        if (entry.mBounds.Contains(pos) && entry.mActor->IsEnabled() && entry.mActor->GetClickable() &&
+                entry.mDrawable->HitTest(pos))
+        {
+            actor = entry.mActor;
+            return entry.mDrawable;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * Get the key for a cell
+ * @param column Cell column
+ * @param row Cell row
+ * @return Key in mCells
+ */
+unsigned long long SpatialIndex::CellKey(int column, int row) const
+{
+    return ((unsigned long long)(unsigned int)column << 32) | (unsigned int)row;
+}
+
+/**
+ * Get the cell column or row a coordinate is in
+ * @param coordinate x or y in the drawing
+ * @return Column or row
+ */
+int SpatialIndex::Cell(int coordinate) const
+{
+    // Round down, also for negative coordinates
+    return coordinate >= 0 ? coordinate / mCellSize : -((-coordinate - 1) / mCellSize) - 1;
+}
+
+/**
+ * List a drawable in the cells its bounds touch
+ * @param entry Index of the drawable in mEntries
+ */
+void SpatialIndex::AddToCells(int entry)
+{
+    if (mEntries[entry].mEmpty)
+    {
+        return;
+    }
+
+    auto const &bounds = mEntries[entry].mBounds;
+    for (int row = Cell(bounds.GetTop()); row <= Cell(bounds.GetBottom()); row++)
+    {
+        for (int column = Cell(bounds.GetLeft()); column <= Cell(bounds.GetRight()); column++)
+        {
+            // Later entries are in front, so the list is kept in descending order
+            auto &cell = mCells[CellKey(column, row)];
+            cell.insert(std::lower_bound(cell.begin(), cell.end(), entry, std::greater<int>()), entry);
+        }
+    }
+}
+
+/**
+ * Remove a drawable from the cells it is listed in
+ * @param entry Index of the drawable in mEntries
+ */
+void SpatialIndex::RemoveFromCells(int entry)
+{
+    if (mEntries[entry].mEmpty)
+    {
+        return;
+    }
+
+    auto const &bounds = mEntries[entry].mBounds;
+    for (int row = Cell(bounds.GetTop()); row <= Cell(bounds.GetBottom()); row++)
+    {
+        for (int column = Cell(bounds.GetLeft()); column <= Cell(bounds.GetRight()); column++)
+        {
+            auto &cell = mCells[CellKey(column, row)];
+            auto loc = std::lower_bound(cell.begin(), cell.end(), entry, std::greater<int>());
+            if (loc != cell.end() && *loc == entry)
+            {
+                cell.erase(loc);
+            }
+        }
+    }
+
+    mEntries[entry].mEmpty = true;
+}
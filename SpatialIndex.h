@@ -0,0 +1,114 @@
+/**
+ * @file SpatialIndex.h
+ * @author Noah Wolff
+ *
+ * Uniform grid of placed drawables for hit testing.
+ */
+
+#ifndef CANADIANEXPERIENCE_SPATIALINDEX_H
+#define CANADIANEXPERIENCE_SPATIALINDEX_H
+
+#include <vector>
+#include <unordered_map>
+
+class Actor;
+class Drawable;
+
+
+/**
+ * Uniform grid of placed drawables for hit testing.
+ *
+ * Each drawable is listed in every grid cell its bounding box
+ * touches. A hit test only looks at the drawables listed in the
+ * cell under the point. Each cell keeps its drawables sorted front
+ * to back, so the test can stop at the first hit.
+ *
+ * The drawables must be added in drawing order. Refresh moves a
+ * drawable to new cells only if it was placed again since the
+ * last refresh.
+ */
+class SpatialIndex {
+private:
+    /**
+     * A drawable in the index
+     */
+    struct Entry {
+        /// The actor the drawable belongs to
+        std::shared_ptr<Actor> mActor;
+
+        /// The drawable
+        std::shared_ptr<Drawable> mDrawable;
+
+        /// Drawable placement version the cells are for
+        int mPlacedVersion = -1;
+
+        /// Bounding box in the drawing
+        wxRect mBounds;
+
+        /// Are the bounds empty, so the drawable is in no cells?
+        bool mEmpty = true;
+    };
+
+    /// Width and height of a grid cell in pixels
+    int mCellSize;
+
+    /// The drawables, in drawing order
+    std::vector<Entry> mEntries;
+
+    /// Union of the old and new bounds of every drawable
+    /// that moved since TakeDamage was last called
+    wxRect mDamage;
+
+    /// Index in mEntries of the drawables in each cell, from
+    /// the front to the back. The key is from CellKey.
+    std::unordered_map<unsigned long long, std::vector<int>> mCells;
+
+    unsigned long long CellKey(int column, int row) const;
+
+    int Cell(int coordinate) const;
+
+    void AddToCells(int entry);
+
+    void RemoveFromCells(int entry);
+
+public:
+    /// Default width and height of a grid cell in pixels
+    static const int DefaultCellSize = 64;
+
+    SpatialIndex(int cellSize = DefaultCellSize);
+
+    /// Copy constructor (disabled)
+    SpatialIndex(const SpatialIndex &) = delete;
+
+    /// Assignment operator
+    void operator=(const SpatialIndex &) = delete;
+
+    void Clear();
+
+    void Add(std::shared_ptr<Actor> actor, std::shared_ptr<Drawable> drawable);
+
+    void Refresh();
+
+    std::shared_ptr<Drawable> HitTest(wxPoint pos, std::shared_ptr<Actor> &actor) const;
+
+    wxRect TakeDamage();
+
+    /**
+     * Get the number of drawables in the index
+     * @return Number of drawables
+     */
+    int GetNumDrawables() const { return (int)mEntries.size(); }
+
+    /**
+     * Get the number of drawables that could be under a point
+     * @param pos Position in the drawing
+     * @return Number of drawables listed in the cell under pos
+     */
+    int GetNumCandidates(wxPoint pos) const
+    {
+        auto cell = mCells.find(CellKey(Cell(pos.x), Cell(pos.y)));
+        return cell == mCells.end() ? 0 : (int)cell->second.size();
+    }
+};
+
+#endif //CANADIANEXPERIENCE_SPATIALINDEX_H
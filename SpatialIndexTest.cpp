@@ -0,0 +1,139 @@
+/**
+ * @file SpatialIndexTest.cpp
+ * @author Noah Wolff
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <SpatialIndex.h>
+#include <Picture.h>
+#include <Actor.h>
+#include <Drawable.h>
+using namespace std;
+
+/// A rectangle that is hit anywhere inside it
+class RectangleMock : public Drawable
+{
+private:
+    wxRect mRect;
+
+public:
+    RectangleMock(const std::wstring &name, wxRect rect) : Drawable(name), mRect(rect) {}
+
+    void Render(Renderer &renderer, const Affine &placed) const override {}
+
+    bool HitTest(wxPoint pos) override
+    {
+        auto local = GetPlacedInverse().Apply(pos);
+        return local.m_x >= mRect.x && local.m_y >= mRect.y &&
+                local.m_x < mRect.x + mRect.width && local.m_y < mRect.y + mRect.height;
+    }
+
+    bool GetLocalBounds(wxRect &bounds) override
+    {
+        bounds = mRect;
+        return true;
+    }
+};
+
+/// Add an actor with one rectangle to a picture
+static shared_ptr<RectangleMock> AddRectangle(Picture &picture, const std::wstring &name, wxPoint position)
+{
+    auto actor = make_shared<Actor>(name);
+    auto rectangle = make_shared<RectangleMock>(name, wxRect(0, 0, 100, 50));
+    actor->AddDrawable(rectangle);
+    actor->SetRoot(rectangle);
+    actor->SetPosition(position);
+    picture.AddActor(actor);
+    return rectangle;
+}
+
+TEST(SpatialIndexTest, HitTest)
+{
+    Picture picture;
+    auto back = AddRectangle(picture, L"Back", wxPoint(0, 0));
+    auto front = AddRectangle(picture, L"Front", wxPoint(50, 25));
+    auto distant = AddRectangle(picture, L"Distant", wxPoint(1000, 600));
+
+    // Where they overlap, the one drawn last wins
+    shared_ptr<Actor> actor;
+    ASSERT_EQ(front, picture.HitTest(wxPoint(60, 30), actor));
+    ASSERT_EQ(L"Front", actor->GetName());
+    ASSERT_EQ(back, picture.HitTest(wxPoint(10, 10), actor));
+    ASSERT_EQ(distant, picture.HitTest(wxPoint(1010, 610), actor));
+    ASSERT_EQ(nullptr, picture.HitTest(wxPoint(500, 300), actor));
+
+    // Moving is picked up on the next hit test
+    front->SetRotation(M_PI);
+    ASSERT_EQ(back, picture.HitTest(wxPoint(60, 30), actor));
+    ASSERT_EQ(front, picture.HitTest(wxPoint(40, 20), actor));
+
+    // Actors that are not clickable are skipped
+    actor->SetClickable(false);
+    ASSERT_EQ(back, picture.HitTest(wxPoint(40, 20), actor));
+}
+
+TEST(SpatialIndexTest, Candidates)
+{
+    SpatialIndex index(64);
+    auto actor = make_shared<Actor>(L"Crowd");
+    for (int i = 0; i < 100; i++)
+    {
+        auto rectangle = make_shared<RectangleMock>(L"R", wxRect(0, 0, 10, 10));
+        rectangle->Place(Affine::Translation(i * 100, -i * 100));
+        index.Add(actor, rectangle);
+    }
+
+    index.Refresh();
+    ASSERT_EQ(100, index.GetNumDrawables());
+
+    // Only the drawable near the point is a candidate
+    ASSERT_EQ(1, index.GetNumCandidates(wxPoint(5005, -4995)));
+    ASSERT_EQ(0, index.GetNumCandidates(wxPoint(5100, -4900)));
+
+    shared_ptr<Actor> hit;
+    ASSERT_NE(nullptr, index.HitTest(wxPoint(5005, -4995), hit));
+    ASSERT_EQ(actor, hit);
+}
+
+TEST(SpatialIndexTest, Damage)
+{
+    Picture picture;
+    auto left = AddRectangle(picture, L"Left", wxPoint(0, 0));
+    auto right = AddRectangle(picture, L"Right", wxPoint(500, 0));
+
+    // Everything the first time
+    ASSERT_EQ(wxRect(0, 0, picture.GetSize().GetWidth(), picture.GetSize().GetHeight()), picture.TakeDamage());
+
+    // Nothing moved
+    ASSERT_TRUE(picture.TakeDamage().IsEmpty());
+
+    // Where the moved rectangle was and where it is now, with a margin
+    right->SetPosition(wxPoint(0, 100));
+    wxRect damage = picture.TakeDamage();
+    ASSERT_TRUE(damage.Contains(wxPoint(500, 0)));
+    ASSERT_TRUE(damage.Contains(wxPoint(599, 149)));
+    ASSERT_FALSE(damage.Contains(wxPoint(400, 0)));
+    ASSERT_FALSE(damage.Contains(wxPoint(500, 160)));
+    ASSERT_TRUE(picture.TakeDamage().IsEmpty());
+}
+
+TEST(SpatialIndexTest, AddDrawableLater)
+{
+    Picture picture;
+    auto actor = make_shared<Actor>(L"Actor");
+    auto root = make_shared<RectangleMock>(L"Root", wxRect(0, 0, 100, 50));
+    actor->AddDrawable(root);
+    actor->SetRoot(root);
+    picture.AddActor(actor);
+
+    shared_ptr<Actor> hit;
+    ASSERT_EQ(nullptr, picture.HitTest(wxPoint(310, 210), hit));
+
+    // A drawable added to an actor already in the picture can be hit
+    auto later = make_shared<RectangleMock>(L"Later", wxRect(0, 0, 20, 20));
+    later->SetPosition(wxPoint(300, 200));
+    actor->AddDrawable(later);
+    root->AddChild(later);
+    ASSERT_EQ(later, picture.HitTest(wxPoint(310, 210), hit));
+}
@@ -0,0 +1,126 @@
+/**
+ * @file ThreadPool.cpp
+ * @author Noah Wolff
+ */
+
+#include "pch.h"
+#include "ThreadPool.h"
+
+/// Chunks per thread, so a slow chunk does not hold up the others
+const int ChunksPerThread = 4;
+
+
+/**
+ * Constructor
+ * @param numThreads Number of threads to work on a job, including
+ * the thread that calls ParallelFor. 1 runs everything on the caller.
+ */
+ThreadPool::ThreadPool(int numThreads)
+{
+    for (int i = 1; i < numThreads; i++)
+    {
+        mThreads.emplace_back(&ThreadPool::Worker, this);
+    }
+}
+
+/**
+ * Destructor
+ */
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+
+    mWork.notify_all();
+    for (auto &thread : mThreads)
+    {
+        thread.join();
+    }
+}
+
+/**
+ * Run a loop over the indices [0, count) in chunks across the threads.
+ *
+ * The task is called with a range [begin, end) of indices and must not
+ * touch anything another range touches. Returns when all chunks are done.
+ * @param count Number of indices
+ * @param minChunk Smallest chunk worth handing to another thread
+ * @param task Function to call for each chunk
+ */
+void ThreadPool::ParallelFor(int count, int minChunk, const std::function<void(int, int)> &task)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    int maxChunks = (count + minChunk - 1) / minChunk;
+    int numChunks = std::min(maxChunks, GetNumThreads() * ChunksPerThread);
+    if (mThreads.empty() || numChunks <= 1)
+    {
+        // Not worth waking anyone up
+        task(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTask = &task;
+        mCount = count;
+        mChunkSize = (count + numChunks - 1) / numChunks;
+        mNumChunks = (count + mChunkSize - 1) / mChunkSize;
+        mNextChunk = 0;
+        mActive = (int)mThreads.size();
+        mGeneration++;
+    }
+
+    mWork.notify_all();
+    RunChunks();
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDone.wait(lock, [this] { return mActive == 0; });
+    mTask = nullptr;
+}
+
+/**
+ * Take chunks of the current job until there are none left.
+ */
+void ThreadPool::RunChunks()
+{
+    for (int chunk = mNextChunk++; chunk < mNumChunks; chunk = mNextChunk++)
+    {
+        int begin = chunk * mChunkSize;
+        int end = std::min(begin + mChunkSize, mCount);
+        (*mTask)(begin, end);
+    }
+}
+
+/**
+ * Worker thread loop
+ */
+void ThreadPool::Worker()
+{
+    unsigned long seen = 0;
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true)
+    {
+        mWork.wait(lock, [this, seen] { return mStop || mGeneration != seen; });
+        if (mStop)
+        {
+            return;
+        }
+
+        seen = mGeneration;
+        lock.unlock();
+        RunChunks();
+        lock.lock();
+
+        if (--mActive == 0)
+        {
+            mDone.notify_one();
+        }
+    }
+}
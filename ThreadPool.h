@@ -0,0 +1,90 @@
+/**
+ * @file ThreadPool.h
+ * @author Noah Wolff
+ *
+ * A fixed set of worker threads for splitting loops into chunks.
+ */
+
+#ifndef CANADIANEXPERIENCE_THREADPOOL_H
+#define CANADIANEXPERIENCE_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/**
+ * A fixed set of worker threads for splitting loops into chunks.
+ *
+ * ParallelFor splits a range of indices into contiguous chunks that
+ * the workers and the calling thread take in turn. The chunks must be
+ * independent of each other, in which case the result is the same as
+ * running the loop on one thread.
+ */
+class ThreadPool {
+private:
+    /// The worker threads
+    std::vector<std::thread> mThreads;
+
+    /// Protects the job state below
+    std::mutex mMutex;
+
+    /// Signals the workers that there is a job or that we are stopping
+    std::condition_variable mWork;
+
+    /// Signals the caller that all workers are done with the job
+    std::condition_variable mDone;
+
+    /// The current job
+    const std::function<void(int, int)> *mTask = nullptr;
+
+    /// Number of indices in the current job
+    int mCount = 0;
+
+    /// Number of indices in each chunk of the current job
+    int mChunkSize = 0;
+
+    /// Number of chunks in the current job
+    int mNumChunks = 0;
+
+    /// The next chunk to be taken
+    std::atomic<int> mNextChunk{0};
+
+    /// Workers still working on the current job
+    int mActive = 0;
+
+    /// Incremented for every job so workers see each one exactly once
+    unsigned long mGeneration = 0;
+
+    /// Set when the pool is being destroyed
+    bool mStop = false;
+
+    void Worker();
+
+    void RunChunks();
+
+public:
+    ThreadPool(int numThreads);
+
+    /// Copy constructor (disabled)
+    ThreadPool(const ThreadPool &) = delete;
+
+    /// Assignment operator
+    void operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool();
+
+    void ParallelFor(int count, int minChunk, const std::function<void(int, int)> &task);
+
+    /**
+     * Get the number of threads that work on a job,
+     * including the calling thread
+     * @return Number of threads
+     */
+    int GetNumThreads() const { return (int)mThreads.size() + 1; }
+};
+
+#endif //CANADIANEXPERIENCE_THREADPOOL_H
@@ -7,6 +7,9 @@
 #include "Timeline.h"
 #include "AnimChannel.h"
 
+/// Smallest number of channels worth editing on another thread
+const int MinEditChunk = 64;
+
 
 /**
  * Constructor
@@ -24,21 +27,204 @@ Timeline::Timeline()
  */
 void Timeline::SetCurrentTime(double t)
 {
+    double frames = t * mFrameRate;
+    int frame = (int)floor(frames);
+    EvaluateFrame(frame, frames - frame);
+
+    // Keep the exact time we were given
     mCurrentTime = t;
+}
+
+/**
+ * Move to a frame and evaluate all of the channels for it.
+ *
+ * The channels are given the frame number and subframe directly
+ * and compute their t values from integer frame differences, so a
+ * frame always evaluates to the same values. Playback and exporting
+ * go through here. Frames in range with no subframe use the baked
+ * values when the timeline is baked.
+ * @param frame The frame
+ * @param subframe Fraction of the way to the next frame, in [0, 1)
+ */
+void Timeline::EvaluateFrame(int frame, double subframe)
+{
+    mCurrentFrame = frame;
+    mCurrentTime = (frame + subframe) / mFrameRate;
     mPointerLoc.x = (int)(mCurrentTime * mFrameRate * 4 + 10); //< I don't think this line should be here
 
-    for (auto channel : mChannels)
+    if (mBaked && subframe == 0 && frame >= 0 && frame < mNumFrames)
+    {
+        mAngleChannels.SetBakedFrame(frame, *mThreadPool);
+        mPositionChannels.SetBakedFrame(frame, *mThreadPool);
+
+        for (auto channel : mUnbatchedChannels)
+        {
+            channel->SetBakedFrame(frame);
+        }
+
+        return;
+    }
+
+    mAngleChannels.SetFrame(frame, subframe, *mThreadPool);
+    mPositionChannels.SetFrame(frame, subframe, *mThreadPool);
+
+    for (auto channel : mUnbatchedChannels)
     {
-        channel->SetFrame(GetCurrentFrame());
+        channel->SetFrame(frame, subframe);
     }
 }
 
 /**
  * Add a channel to the timeline
+ *
+ * The channel is evaluated on its own. Angle and position
+ * channels are added to batches by the other overloads.
  * @param channel Channel to add
  */
 void Timeline::AddChannel(AnimChannel* channel)
 {
     mChannels.push_back(channel);
+    mUnbatchedChannels.push_back(channel);
     channel->SetTimeline(this);
 }
+
+/**
+ * Add an angle channel to the timeline
+ * @param channel Channel to add
+ */
+void Timeline::AddChannel(AnimChannelT<double>* channel)
+{
+    mChannels.push_back(channel);
+    mAngleChannels.Add(channel);
+    channel->SetTimeline(this);
+}
+
+/**
+ * Add a position channel to the timeline
+ * @param channel Channel to add
+ */
+void Timeline::AddChannel(AnimChannelT<wxPoint>* channel)
+{
+    mChannels.push_back(channel);
+    mPositionChannels.Add(channel);
+    channel->SetTimeline(this);
+}
+
+/**
+ * Set the number of threads used to evaluate the animation
+ *
+ * The results are the same for any number of threads.
+ * @param numThreads Number of threads. 1 evaluates on the calling thread only.
+ */
+void Timeline::SetNumThreads(int numThreads)
+{
+    if (numThreads != GetNumThreads())
+    {
+        mThreadPool = std::make_unique<ThreadPool>(std::max(numThreads, 1));
+    }
+}
+
+/**
+ * Turn baked playback on or off
+ *
+ * When baked, every channel is evaluated for every frame up front
+ * and times that fall exactly on a frame are a lookup of those
+ * values. A channel is baked again the next time it is used after
+ * a keyframe is set on it.
+ * @param baked true to play back from baked values
+ */
+void Timeline::SetBaked(bool baked)
+{
+    mBaked = baked;
+    if (mBaked)
+    {
+        Bake();
+    }
+}
+
+/**
+ * Bake every valid channel that is not already baked
+ *
+ * This does not turn on baked playback. It is for reading
+ * the baked values of the channels directly.
+ */
+void Timeline::Bake()
+{
+    mAngleChannels.Bake(*mThreadPool);
+    mPositionChannels.Bake(*mThreadPool);
+
+    for (auto channel : mUnbatchedChannels)
+    {
+        if (channel->IsValid() && !channel->IsBaked())
+        {
+            channel->Bake();
+        }
+    }
+}
+
+/**
+ * Delete the keyframes in a range of frames from every channel
+ *
+ * Call Picture::SetAnimationTime afterwards to see the result.
+ * @param first First frame of the range
+ * @param last Last frame of the range, inclusive
+ */
+void Timeline::DeleteKeyframes(int first, int last)
+{
+    ForEachChannel([first, last](AnimChannel *channel) { channel->DeleteKeyframes(first, last); });
+}
+
+/**
+ * Move the keyframes in a range of frames in every channel
+ *
+ * Call Picture::SetAnimationTime afterwards to see the result.
+ * @param first First frame of the range
+ * @param last Last frame of the range, inclusive
+ * @param offset Number of frames to move by, negative to move earlier
+ */
+void Timeline::ShiftKeyframes(int first, int last, int offset)
+{
+    ForEachChannel([first, last, offset](AnimChannel *channel) { channel->ShiftKeyframes(first, last, offset); });
+}
+
+/**
+ * Retime the keyframes in a range of frames in every channel
+ *
+ * Call Picture::SetAnimationTime afterwards to see the result.
+ * @param first First frame of the range, which stays put
+ * @param last Last frame of the range, inclusive
+ * @param scale Scale factor for the distance from the first frame
+ */
+void Timeline::ScaleKeyframes(int first, int last, double scale)
+{
+    ForEachChannel([first, last, scale](AnimChannel *channel) { channel->ScaleKeyframes(first, last, scale); });
+}
+
+/**
+ * Set how every channel leaves its keyframes in a range of frames
+ *
+ * Call Picture::SetAnimationTime afterwards to see the result.
+ * @param first First frame of the range
+ * @param last Last frame of the range, inclusive
+ * @param interpolation Interpolation to the next keyframe
+ */
+void Timeline::SetInterpolation(int first, int last, AnimChannel::Interpolation interpolation)
+{
+    ForEachChannel([first, last, interpolation](AnimChannel *channel) {
+        channel->SetInterpolation(first, last, interpolation);
+    });
+}
+
+/**
+ * Apply an edit to every channel, split across the timeline threads
+ * @param edit Edit to apply to one channel
+ */
+void Timeline::ForEachChannel(const std::function<void(AnimChannel *)> &edit)
+{
+    mThreadPool->ParallelFor((int)mChannels.size(), MinEditChunk, [this, &edit](int begin, int end) {
+        for (int i = begin; i < end; i++)
+        {
+            edit(mChannels[i]);
+        }
+    });
+}
@@ -8,7 +8,7 @@
 #ifndef CANADIANEXPERIENCE_TIMELINE_H
 #define CANADIANEXPERIENCE_TIMELINE_H
 
-class AnimChannel;
+#include "AnimChannelBatch.h"
 
 
 /**
@@ -29,12 +29,32 @@ private:
     /// Current time
     double mCurrentTime = 0;
 
+    /// Current frame
+    int mCurrentFrame = 0;
+
     /// Pointer Location
     wxPoint mPointerLoc = wxPoint(9, 11);
 
     /// List of all animation channels
     std::vector<AnimChannel *> mChannels;
 
+    /// Channels that are not part of a batch
+    std::vector<AnimChannel *> mUnbatchedChannels;
+
+    /// All angle channels, evaluated together
+    AnimChannelBatch<double> mAngleChannels;
+
+    /// All position channels, evaluated together
+    AnimChannelBatch<wxPoint> mPositionChannels;
+
+    /// Are we playing back from baked channel values?
+    bool mBaked = false;
+
+    /// Threads used to evaluate the channels
+    std::unique_ptr<ThreadPool> mThreadPool = std::make_unique<ThreadPool>(1);
+
+    void ForEachChannel(const std::function<void(AnimChannel *)> &edit);
+
 public:
     /// Constructor
     Timeline();
@@ -49,8 +69,28 @@ public:
 
     void SetCurrentTime(double t);
 
+    void EvaluateFrame(int frame, double subframe = 0);
+
     void AddChannel(AnimChannel* channel);
 
+    void AddChannel(AnimChannelT<double>* channel);
+
+    void AddChannel(AnimChannelT<wxPoint>* channel);
+
+    void SetNumThreads(int numThreads);
+
+    void SetBaked(bool baked);
+
+    void Bake();
+
+    void DeleteKeyframes(int first, int last);
+
+    void ShiftKeyframes(int first, int last, int offset);
+
+    void ScaleKeyframes(int first, int last, double scale);
+
+    void SetInterpolation(int first, int last, AnimChannel::Interpolation interpolation);
+
 
 
     /**
@@ -79,9 +119,16 @@ public:
 
     /**
      * Set the frame rate
+     *
+     * The current time stays the same, so the current
+     * frame changes to the one at that time.
      * @param frameRate Animation frame rate in frames per second
      */
-    void SetFrameRate(int frameRate) { mFrameRate = frameRate; }
+    void SetFrameRate(int frameRate)
+    {
+        mFrameRate = frameRate;
+        mCurrentFrame = (int)floor(mCurrentTime * mFrameRate);
+    }
 
     /**
      * Get the animation duration
@@ -94,7 +141,25 @@ public:
      * This is the frame associated with the current time
      * @return Current frame
      */
-    int GetCurrentFrame() const { return floor(mCurrentTime * mFrameRate); }
+    int GetCurrentFrame() const { return mCurrentFrame; }
+
+    /**
+     * Are we playing back from baked channel values?
+     * @return true if baked
+     */
+    bool IsBaked() const { return mBaked; }
+
+    /**
+     * Get the number of threads used to evaluate the animation
+     * @return Number of threads, 1 if evaluation is serial
+     */
+    int GetNumThreads() const { return mThreadPool->GetNumThreads(); }
+
+    /**
+     * Get the thread pool used to evaluate the animation
+     * @return Thread pool
+     */
+    ThreadPool *GetThreadPool() { return mThreadPool.get(); }
 
     /**
      * Gets the location of the pointer
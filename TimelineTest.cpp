@@ -83,6 +83,17 @@ TEST(TimelineTest, GetCurrentFrame) {
     ASSERT_EQ(278, timeline.GetCurrentFrame());
 }
 
+TEST(TimelineTest, CurrentFrameAfterFrameRate) {
+    Timeline timeline;
+    timeline.SetCurrentTime(2.5);
+    ASSERT_EQ(75, timeline.GetCurrentFrame());
+
+    // The time stays put, so the frame follows the new rate
+    timeline.SetFrameRate(24);
+    ASSERT_DOUBLE_EQ(2.5, timeline.GetCurrentTime());
+    ASSERT_EQ(60, timeline.GetCurrentFrame());
+}
+
 TEST(TimelineTest, Add)
 {
     Timeline timeline;
@@ -92,3 +103,166 @@ TEST(TimelineTest, Add)
     ASSERT_EQ(&timeline, channel.GetTimeline());
 }
 
+
+TEST(TimelineTest, Batch)
+{
+    Timeline timeline;
+
+    // Channels with differing keyframes so some tween and some hold
+    const int NumChannels = 11;
+    std::vector<std::unique_ptr<AnimChannelAngle>> channels;
+    for (int c = 0; c < NumChannels; c++)
+    {
+        channels.push_back(std::make_unique<AnimChannelAngle>());
+        timeline.AddChannel(channels.back().get());
+
+        for (int k = 0; k <= c % 4; k++)
+        {
+            timeline.SetCurrentTime((c + k * 37 + 0.5) / 30.0);
+            channels.back()->SetKeyframe(c * 0.3 - k * 1.7);
+        }
+
+        // Mix of interpolations so the batch evaluates full cubics
+        channels.back()->SetInterpolation(0, 300, AnimChannel::Interpolation(c % 4));
+    }
+
+    for (double subframe : {0.0, 0.25})
+    {
+        for (int frame : {0, 15, 38, 60, 117, 180})
+        {
+            timeline.EvaluateFrame(frame, subframe);
+            for (auto &channel : channels)
+            {
+                // Batched result must match evaluating the channel on its own
+                double batched = channel->GetAngle();
+                channel->SetFrame(frame, subframe);
+                ASSERT_EQ(batched, channel->GetAngle());
+            }
+        }
+    }
+}
+
+TEST(TimelineTest, EvaluateFrame)
+{
+    Timeline timeline;
+    AnimChannelAngle channel;
+    timeline.AddChannel(&channel);
+
+    timeline.EvaluateFrame(10);
+    channel.SetKeyframe(1.0);
+    timeline.EvaluateFrame(20);
+    channel.SetKeyframe(2.0);
+
+    timeline.EvaluateFrame(15);
+    ASSERT_EQ(15, timeline.GetCurrentFrame());
+    ASSERT_DOUBLE_EQ(1.5, channel.GetAngle());
+
+    timeline.EvaluateFrame(15, 0.5);
+    ASSERT_EQ(15, timeline.GetCurrentFrame());
+    ASSERT_DOUBLE_EQ(1.55, channel.GetAngle());
+
+    // Setting the time lands on the same frame and subframe
+    timeline.SetCurrentTime(15.5 / 30.0);
+    ASSERT_EQ(15, timeline.GetCurrentFrame());
+    ASSERT_NEAR(1.55, channel.GetAngle(), 1e-9);
+}
+
+TEST(TimelineTest, Threads)
+{
+    Timeline serial;
+    Timeline threaded;
+    threaded.SetNumThreads(4);
+    ASSERT_EQ(4, threaded.GetNumThreads());
+
+    // Enough channels that the work is split into chunks
+    const int NumChannels = 3000;
+    std::vector<std::unique_ptr<AnimChannelAngle>> serialChannels;
+    std::vector<std::unique_ptr<AnimChannelAngle>> threadedChannels;
+    for (int c = 0; c < NumChannels; c++)
+    {
+        serialChannels.push_back(std::make_unique<AnimChannelAngle>());
+        threadedChannels.push_back(std::make_unique<AnimChannelAngle>());
+        serial.AddChannel(serialChannels.back().get());
+        threaded.AddChannel(threadedChannels.back().get());
+
+        for (int k = 0; k <= c % 3; k++)
+        {
+            double time = (c % 50 + k * 40 + 0.5) / 30.0;
+            serial.SetCurrentTime(time);
+            threaded.SetCurrentTime(time);
+            serialChannels.back()->SetKeyframe(c * 0.01 + k);
+            threadedChannels.back()->SetKeyframe(c * 0.01 + k);
+        }
+    }
+
+    for (double time : {0.0, 1.1, 2.5, 4.0})
+    {
+        serial.SetCurrentTime(time);
+        threaded.SetCurrentTime(time);
+        for (int c = 0; c < NumChannels; c++)
+        {
+            ASSERT_EQ(serialChannels[c]->GetAngle(), threadedChannels[c]->GetAngle());
+        }
+    }
+}
+
+TEST(TimelineTest, Baked)
+{
+    Timeline timeline;
+    AnimChannelAngle channel1;
+    AnimChannelAngle channel2;
+    timeline.AddChannel(&channel1);
+    timeline.AddChannel(&channel2);
+
+    timeline.SetCurrentTime(1.0);
+    channel1.SetKeyframe(1.0);
+    channel2.SetKeyframe(-1.0);
+    timeline.SetCurrentTime(3.0);
+    channel1.SetKeyframe(3.0);
+    channel2.SetKeyframe(-3.0);
+
+    // Unbaked values at every frame
+    std::vector<double> expected;
+    for (int frame = 0; frame < timeline.GetNumFrames(); frame++)
+    {
+        timeline.SetCurrentTime(frame / 30.0);
+        expected.push_back(channel1.GetAngle());
+    }
+
+    timeline.SetBaked(true);
+    ASSERT_TRUE(channel1.IsBaked());
+    ASSERT_TRUE(channel2.IsBaked());
+
+    for (int frame = 0; frame < timeline.GetNumFrames(); frame++)
+    {
+        timeline.SetCurrentTime(frame / 30.0);
+        ASSERT_NEAR(expected[frame], channel1.GetAngle(), 0.000001);
+    }
+
+    // Editing one channel only unbakes that channel
+    timeline.SetCurrentTime(2.0);
+    channel1.SetKeyframe(10.0);
+    ASSERT_FALSE(channel1.IsBaked());
+    ASSERT_TRUE(channel2.IsBaked());
+
+    timeline.SetCurrentTime(2.0);
+    ASSERT_TRUE(channel1.IsBaked());
+    ASSERT_NEAR(10.0, channel1.GetAngle(), 0.000001);
+    ASSERT_NEAR(-2.0, channel2.GetAngle(), 0.000001);
+}
+
+TEST(TimelineTest, DeleteKeyframes)
+{
+    Timeline timeline;
+    AnimChannelAngle channel1;
+    AnimChannelAngle channel2;
+    timeline.AddChannel(&channel1);
+    timeline.AddChannel(&channel2);
+
+    channel1.SetKeyframes({{10, 1}, {20, 2}, {30, 3}});
+    channel2.SetKeyframes({{20, 2}});
+
+    timeline.DeleteKeyframes(20, 20);
+    ASSERT_EQ(2, channel1.GetNumKeyframes());
+    ASSERT_FALSE(channel2.IsValid());
+}
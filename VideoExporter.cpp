@@ -0,0 +1,142 @@
+/**
+ * @file VideoExporter.cpp
+ * @author Noah Wolff
+ */
+
+#include "pch.h"
+#include "VideoExporter.h"
+#include "VideoWriter.h"
+#include "FrameExporter.h"
+#include "Picture.h"
+#include "CpuRenderer.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/// Slots for each rendering thread when no capacity is given,
+/// so a thread can start the next frame while the last one waits
+const int SlotsPerThread = 2;
+
+/**
+ * Constructor
+ * @param picture The picture to render
+ * @param numThreads Number of threads to render on,
+ * 0 for one for each core
+ * @param capacity Number of frames that can be held at once,
+ * 0 for two for each thread
+ */
+VideoExporter::VideoExporter(Picture *picture, int numThreads, int capacity) :
+        mPicture(picture)
+{
+    mNumThreads = numThreads > 0 ? numThreads : std::max(1, (int)std::thread::hardware_concurrency());
+    mCapacity = capacity > 0 ? capacity : mNumThreads * SlotsPerThread;
+}
+
+/**
+ * Render a range of frames into a video
+ *
+ * Frames outside of the timeline are skipped. This calls Begin,
+ * WriteFrame for every frame in order and End on the writer, all
+ * on the calling thread. Rendering stops early if the writer fails.
+ * @param writer Writer to hand the frames to
+ * @param first First frame
+ * @param last Last frame, inclusive
+ * @return true if every frame was written
+ */
+bool VideoExporter::Export(VideoWriter &writer, int first, int last)
+{
+    auto timeline = mPicture->GetTimeline();
+    first = std::max(first, 0);
+    last = std::min(last, timeline->GetNumFrames() - 1);
+    if (last < first)
+    {
+        return false;
+    }
+
+    FrameExporter::Prepare(*mPicture);
+
+    int count = last - first + 1;
+    auto size = mPicture->GetSize();
+    if (!writer.Begin(size.GetWidth(), size.GetHeight(), timeline->GetFrameRate(), count))
+    {
+        return false;
+    }
+
+    int capacity = std::min(mCapacity, count);
+    std::vector<std::unique_ptr<CpuRenderer>> slots;
+    for (int i = 0; i < capacity; i++)
+    {
+        slots.push_back(std::make_unique<CpuRenderer>(size.GetWidth(), size.GetHeight()));
+    }
+
+    // Everything below is protected by mutex
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<bool> ready(capacity, false);
+    int nextRender = 0;
+    int nextWrite = 0;
+    bool stop = false;
+
+    auto render = [&]() {
+        while (true)
+        {
+            int i;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                if (stop || nextRender >= count)
+                {
+                    return;
+                }
+
+                // Wait until the frame before in this slot is written
+                i = nextRender++;
+                changed.wait(lock, [&]() { return stop || i < nextWrite + capacity; });
+                if (stop)
+                {
+                    return;
+                }
+            }
+
+            FrameExporter::RenderFrame(*mPicture, first + i, mBackground, *slots[i % capacity]);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ready[i % capacity] = true;
+            }
+            changed.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < std::min(mNumThreads, count); t++)
+    {
+        threads.emplace_back(render);
+    }
+
+    bool ok = true;
+    for (int i = 0; i < count && ok; i++)
+    {
+        int slot = i % capacity;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&]() { return ready[slot]; });
+        }
+
+        ok = writer.WriteFrame(slots[slot]->GetImage());
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ready[slot] = false;
+            nextWrite = i + 1;
+            stop = !ok;
+        }
+        changed.notify_all();
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    return ok && writer.End();
+}
@@ -0,0 +1,73 @@
+/**
+ * @file VideoExporter.h
+ * @author Noah Wolff
+ *
+ * Renders frames of a picture straight into a video stream.
+ */
+
+#ifndef CANADIANEXPERIENCE_VIDEOEXPORTER_H
+#define CANADIANEXPERIENCE_VIDEOEXPORTER_H
+
+class Picture;
+class VideoWriter;
+
+
+/**
+ * Renders frames of a picture straight into a video stream.
+ *
+ * Worker threads render frames into a small ring of slots while
+ * the calling thread hands them to the writer. Frame f always goes
+ * in slot f modulo the number of slots, and a worker waits until
+ * the frame that was last in its slot has been written before it
+ * starts. Frames finish in any order, but the writer takes them
+ * strictly in order, and no more frames than there are slots are
+ * ever held, however long the shot is.
+ */
+class VideoExporter {
+private:
+    /// The picture we render
+    Picture *mPicture;
+
+    /// Color under everything
+    wxColour mBackground = *wxWHITE;
+
+    /// Number of threads rendering frames
+    int mNumThreads;
+
+    /// Number of frames that can be rendered and waiting at once
+    int mCapacity;
+
+public:
+    VideoExporter(Picture *picture, int numThreads = 0, int capacity = 0);
+
+    /// Default constructor (disabled)
+    VideoExporter() = delete;
+
+    /// Copy constructor (disabled)
+    VideoExporter(const VideoExporter &) = delete;
+
+    /// Assignment operator
+    void operator=(const VideoExporter &) = delete;
+
+    bool Export(VideoWriter &writer, int first, int last);
+
+    /**
+     * Set the color under everything
+     * @param background Background color
+     */
+    void SetBackground(const wxColour &background) { mBackground = background; }
+
+    /**
+     * Get the number of threads rendering frames
+     * @return Number of threads
+     */
+    int GetNumThreads() const { return mNumThreads; }
+
+    /**
+     * Get the number of frames that can be held at once
+     * @return Number of frames
+     */
+    int GetCapacity() const { return mCapacity; }
+};
+
+#endif //CANADIANEXPERIENCE_VIDEOEXPORTER_H
@@ -0,0 +1,241 @@
+/**
+ * @file VideoExporterTest.cpp
+ * @author Noah Wolff
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <VideoExporter.h>
+#include <FrameExporter.h>
+#include <RgbaWriter.h>
+#include <Y4mWriter.h>
+#include <ApngWriter.h>
+#include <CpuRenderer.h>
+#include <Picture.h>
+#include <Actor.h>
+#include <PolyDrawable.h>
+#include <sstream>
+
+/**
+ * Make a small picture with a translucent triangle that slides
+ * across it, so every frame is different
+ * @param picture Picture to add to
+ */
+static void MakeSlide(Picture &picture)
+{
+    picture.SetSize(wxSize(64, 48));
+
+    auto actor = std::make_shared<Actor>(L"Slider");
+    auto triangle = std::make_shared<PolyDrawable>(L"Triangle");
+    triangle->SetColor(wxColour(40, 120, 200, 160));
+    triangle->AddPoint(wxPoint(0, -10));
+    triangle->AddPoint(wxPoint(10, 10));
+    triangle->AddPoint(wxPoint(-10, 10));
+    actor->AddDrawable(triangle);
+    actor->SetRoot(triangle);
+    picture.AddActor(actor);
+
+    actor->SetPosition(wxPoint(0, 24));
+    actor->SetKeyframe();
+    picture.SetAnimationFrame(30);
+    actor->SetPosition(wxPoint(64, 24));
+    actor->SetKeyframe();
+}
+
+/**
+ * Read a big-endian number
+ * @param data Bytes
+ * @param offset Offset of the first byte
+ * @return Number
+ */
+static uint32_t Get32(const std::string &data, size_t offset)
+{
+    uint32_t value = 0;
+    for (size_t i = 0; i < 4; i++)
+    {
+        value = (value << 8) | (unsigned char)data[offset + i];
+    }
+
+    return value;
+}
+
+/**
+ * Writer that keeps the pixels of the frames it is given
+ * and fails after a few of them
+ */
+class FailingWriter : public VideoWriter {
+public:
+    /// Pixels of the frames we were given, in order
+    std::vector<std::vector<uint32_t>> mWritten;
+
+    /// Frames to write before failing
+    int mFailAfter;
+
+    /**
+     * Constructor
+     * @param out Stream, which is not used
+     * @param failAfter Frames to write before failing
+     */
+    FailingWriter(std::ostream &out, int failAfter) : VideoWriter(out), mFailAfter(failAfter) {}
+
+    bool WriteFrame(const RenderImage &image) override
+    {
+        const uint32_t *pixels = image.GetPixels();
+        mWritten.emplace_back(pixels, pixels + image.GetWidth() * image.GetHeight());
+        return (int)mWritten.size() < mFailAfter;
+    }
+};
+
+TEST(VideoExporterTest, Construct)
+{
+    Picture picture;
+    VideoExporter exporter(&picture, 3);
+    ASSERT_EQ(3, exporter.GetNumThreads());
+    ASSERT_EQ(6, exporter.GetCapacity());
+
+    VideoExporter exporter2(&picture, 4, 2);
+    ASSERT_EQ(2, exporter2.GetCapacity());
+}
+
+TEST(VideoExporterTest, RawInOrder)
+{
+    Picture picture;
+    MakeSlide(picture);
+
+    const int first = 2;
+    const int last = 25;
+
+    // More threads than slots, so workers have to wait for the writer
+    std::ostringstream out;
+    RgbaWriter writer(out);
+    VideoExporter exporter(&picture, 4, 2);
+    ASSERT_TRUE(exporter.Export(writer, first, last));
+
+    // The same frames rendered one at a time
+    FrameExporter frames(&picture, 1);
+    frames.Prepare();
+    CpuRenderer renderer(64, 48);
+    std::string expected;
+    for (int frame = first; frame <= last; frame++)
+    {
+        frames.RenderFrame(frame, renderer);
+        const uint32_t *pixels = renderer.GetImage().GetPixels();
+        for (int i = 0; i < 64 * 48; i++)
+        {
+            uint32_t pixel = RenderImage::Unpremultiply(pixels[i]);
+            for (int c = 0; c < 4; c++)
+            {
+                expected.push_back((char)(pixel >> (c * 8)));
+            }
+        }
+    }
+
+    ASSERT_EQ(expected.size(), out.str().size());
+    ASSERT_TRUE(expected == out.str());
+}
+
+TEST(VideoExporterTest, Y4m)
+{
+    Picture picture;
+    MakeSlide(picture);
+
+    std::ostringstream out;
+    Y4mWriter writer(out);
+    VideoExporter exporter(&picture, 2);
+    ASSERT_TRUE(exporter.Export(writer, 0, 9));
+
+    auto data = out.str();
+    std::string header = "YUV4MPEG2 W64 H48 F30:1 Ip A1:1 C444\n";
+    ASSERT_EQ(header, data.substr(0, header.size()));
+
+    size_t frameSize = 6 + 64 * 48 * 3;
+    ASSERT_EQ(header.size() + frameSize * 10, data.size());
+    ASSERT_EQ(std::string("FRAME\n"), data.substr(header.size() + frameSize * 9, 6));
+
+    // The background is white, which is Y 235 in video range
+    size_t planes = header.size() + 6;
+    ASSERT_EQ(235, (unsigned char)data[planes]);
+    ASSERT_EQ(128, (unsigned char)data[planes + 64 * 48]);
+    ASSERT_EQ(128, (unsigned char)data[planes + 64 * 48 * 2]);
+}
+
+TEST(VideoExporterTest, Apng)
+{
+    // The CRC of an empty IEND chunk is in every PNG file
+    ASSERT_EQ(0xae426082u, ApngWriter::Crc((const unsigned char *)"IEND", 4));
+
+    Picture picture;
+    MakeSlide(picture);
+
+    std::ostringstream out;
+    ApngWriter writer(out);
+    VideoExporter exporter(&picture, 3);
+    ASSERT_TRUE(exporter.Export(writer, 0, 4));
+
+    auto data = out.str();
+    ASSERT_EQ(std::string("\x89PNG\r\n\x1a\n", 8), data.substr(0, 8));
+
+    // Walk the chunks, checking each CRC and the sequence numbers
+    std::vector<std::string> types;
+    uint32_t sequence = 0;
+    size_t offset = 8;
+    while (offset < data.size())
+    {
+        uint32_t length = Get32(data, offset);
+        auto type = data.substr(offset + 4, 4);
+        auto crc = ApngWriter::Crc((const unsigned char *)data.data() + offset + 4, length + 4);
+        ASSERT_EQ(crc, Get32(data, offset + 8 + length)) << type;
+
+        size_t body = offset + 8;
+        if (type == "IHDR")
+        {
+            ASSERT_EQ(64u, Get32(data, body));
+            ASSERT_EQ(48u, Get32(data, body + 4));
+        }
+        else if (type == "acTL")
+        {
+            ASSERT_EQ(5u, Get32(data, body));
+        }
+        else if (type == "fcTL" || type == "fdAT")
+        {
+            ASSERT_EQ(sequence++, Get32(data, body));
+        }
+
+        types.push_back(type);
+        offset += 12 + length;
+    }
+
+    ASSERT_EQ(data.size(), offset);
+    std::vector<std::string> expected = {"IHDR", "acTL", "fcTL", "IDAT"};
+    for (int i = 1; i < 5; i++)
+    {
+        expected.push_back("fcTL");
+        expected.push_back("fdAT");
+    }
+    expected.push_back("IEND");
+    ASSERT_EQ(expected, types);
+}
+
+TEST(VideoExporterTest, WriterFails)
+{
+    Picture picture;
+    MakeSlide(picture);
+
+    // Rendering stops and the workers finish when the writer fails
+    std::ostringstream out;
+    FailingWriter writer(out, 3);
+    VideoExporter exporter(&picture, 4, 3);
+    ASSERT_FALSE(exporter.Export(writer, 5, 20));
+    ASSERT_EQ(3u, writer.mWritten.size());
+
+    // The writer got frames 5, 6 and 7 in that order
+    CpuRenderer renderer(64, 48);
+    for (int i = 0; i < 3; i++)
+    {
+        FrameExporter::RenderFrame(picture, 5 + i, *wxWHITE, renderer);
+        const uint32_t *pixels = renderer.GetImage().GetPixels();
+        ASSERT_EQ(std::vector<uint32_t>(pixels, pixels + 64 * 48), writer.mWritten[i]) << "frame " << 5 + i;
+    }
+
+    ASSERT_NE(writer.mWritten[0], writer.mWritten[2]);
+}
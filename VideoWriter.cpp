@@ -0,0 +1,54 @@
+/**
+ * @file VideoWriter.cpp
+ * @author Noah Wolff
+ */
+
+#include "pch.h"
+#include "VideoWriter.h"
+
+/**
+ * Constructor
+ * @param out Stream to write to, opened in binary mode
+ */
+VideoWriter::VideoWriter(std::ostream &out) : mOut(out)
+{
+}
+
+/**
+ * Start the video
+ *
+ * Derived classes write their header after calling this.
+ * @param width Width of the frames in pixels
+ * @param height Height of the frames in pixels
+ * @param frameRate Frames per second
+ * @param numFrames Number of frames that will be written
+ * @return true if the stream is good
+ */
+bool VideoWriter::Begin(int width, int height, int frameRate, int numFrames)
+{
+    mWidth = width;
+    mHeight = height;
+    mFrameRate = frameRate;
+    mNumFrames = numFrames;
+    return mOut.good();
+}
+
+/**
+ * Finish the video and flush the stream
+ * @return true if everything was written
+ */
+bool VideoWriter::End()
+{
+    mOut.flush();
+    return mOut.good();
+}
+
+/**
+ * Write bytes to the stream
+ * @param data Bytes to write
+ * @param size Number of bytes
+ */
+void VideoWriter::Write(const void *data, size_t size)
+{
+    mOut.write((const char *)data, (std::streamsize)size);
+}
@@ -0,0 +1,100 @@
+/**
+ * @file VideoWriter.h
+ * @author Noah Wolff
+ *
+ * Base class for writing rendered frames to a video stream.
+ */
+
+#ifndef CANADIANEXPERIENCE_VIDEOWRITER_H
+#define CANADIANEXPERIENCE_VIDEOWRITER_H
+
+#include <ostream>
+class RenderImage;
+
+
+/**
+ * Base class for writing rendered frames to a video stream.
+ *
+ * Call Begin once, then WriteFrame for each frame in order, then
+ * End. Each frame is written to the stream as soon as it is handed
+ * over, so nothing is kept from one frame to the next and a video
+ * of any length takes the same memory. Every call returns false
+ * once the stream has failed.
+ */
+class VideoWriter {
+private:
+    /// Stream we write to
+    std::ostream &mOut;
+
+    /// Width of the frames in pixels
+    int mWidth = 0;
+
+    /// Height of the frames in pixels
+    int mHeight = 0;
+
+    /// Frames per second
+    int mFrameRate = 30;
+
+    /// Number of frames that will be written
+    int mNumFrames = 0;
+
+protected:
+    VideoWriter(std::ostream &out);
+
+    void Write(const void *data, size_t size);
+
+    /**
+     * Get the stream we write to
+     * @return Output stream
+     */
+    std::ostream &GetStream() { return mOut; }
+
+public:
+    /// Default constructor (disabled)
+    VideoWriter() = delete;
+
+    /// Copy constructor (disabled)
+    VideoWriter(const VideoWriter &) = delete;
+
+    /// Assignment operator
+    void operator=(const VideoWriter &) = delete;
+
+    virtual ~VideoWriter() = default;
+
+    virtual bool Begin(int width, int height, int frameRate, int numFrames);
+
+    /**
+     * Write the next frame
+     * @param image Frame, the size given to Begin
+     * @return true if the stream is still good
+     */
+    virtual bool WriteFrame(const RenderImage &image) = 0;
+
+    virtual bool End();
+
+    /**
+     * Get the width of the frames
+     * @return Width in pixels
+     */
+    int GetWidth() const { return mWidth; }
+
+    /**
+     * Get the height of the frames
+     * @return Height in pixels
+     */
+    int GetHeight() const { return mHeight; }
+
+    /**
+     * Get the frame rate
+     * @return Frames per second
+     */
+    int GetFrameRate() const { return mFrameRate; }
+
+    /**
+     * Get the number of frames that will be written
+     * @return Number of frames
+     */
+    int GetNumFrames() const { return mNumFrames; }
+};
+
+#endif //CANADIANEXPERIENCE_VIDEOWRITER_H
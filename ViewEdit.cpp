@@ -51,15 +51,22 @@ void ViewEdit::OnPaint(wxPaintEvent& event)
     wxAutoBufferedPaintDC dc(this);
     DoPrepareDC(dc);
 
+    // Only the area that needs it is repainted, in picture coordinates
+    wxRect update = GetUpdateRegion().GetBox();
+    update.SetPosition(CalcUnscrolledPosition(update.GetPosition()));
+    dc.SetClippingRegion(update);
+
     wxBrush background(*wxWHITE);
-    dc.SetBackground(background);
-    dc.Clear();
+    dc.SetBrush(background);
+    dc.SetPen(*wxTRANSPARENT_PEN);
+    dc.DrawRectangle(update);
 
     // Create a graphics context
     auto graphics = std::shared_ptr<wxGraphicsContext>(wxGraphicsContext::Create( dc ));
+    graphics->Clip(update.x, update.y, update.width, update.height);
 
     // Additional drawing code here
-    GetPicture()->Draw(graphics);
+    GetPicture()->Draw(graphics, update);
 }
 
 /**
@@ -72,24 +79,12 @@ void ViewEdit::OnLeftDown(wxMouseEvent &event)
     mLastMouse = click;
 
     //
-    // Did we hit anything?
+    // Did we hit anything? The picture gives us the
+    // front-most drawable under the mouse.
     //
 
     std::shared_ptr<Actor> hitActor;
-    std::shared_ptr<Drawable> hitDrawable;
-    for (auto actor : *GetPicture())
-    {
-        // Note: We do not exit when we get the first hit, since
-        // we are looking at these in drawing order. Instead, we
-        // keep the last hit.
-        std::shared_ptr<Drawable> drawable =
-                actor->HitTest(wxPoint(click.x, click.y));
-        if (drawable != nullptr)
-        {
-            hitActor = actor;
-            hitDrawable = drawable;
-        }
-    }
+    std::shared_ptr<Drawable> hitDrawable = GetPicture()->HitTest(wxPoint(click.x, click.y), hitActor);
 
     // If we hit something determine what we do with it based on the
     // current mode.
@@ -199,5 +194,17 @@ void ViewEdit::OnUpdateEditRotate(wxUpdateUIEvent& event)
  */
 void ViewEdit::UpdateObserver()
 {
-    Refresh();
+    // Moving the time without changing any actor needs no redraw
+    if (!GetPicture()->IsPoseChanged())
+    {
+        return;
+    }
+
+    // Only repaint where something moved
+    wxRect damage = GetPicture()->TakeDamage();
+    if (!damage.IsEmpty())
+    {
+        damage.SetPosition(CalcScrolledPosition(damage.GetPosition()));
+        RefreshRect(damage);
+    }
 }
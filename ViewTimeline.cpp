@@ -34,6 +34,10 @@ const int BorderLeft = 10;
 /// Space to the right of the scale
 const int BorderRight = 10;
 
+/// How often the playback timer checks the clock, in milliseconds.
+/// This is shorter than a frame so frames are shown close to on time.
+const int PlaybackTimerInterval = 5;
+
 /// Filename for the pointer image
 const std::wstring PointerImageFile = L"/pointer.png";
 
@@ -50,7 +54,8 @@ ViewTimeline::ViewTimeline(wxFrame* parent, std::wstring imagesDir, Timeline* ti
                 wxDefaultPosition,           // Use the default position
                 wxSize(100, Height), // Set the height to 90 pixels
                                                   // We don't care about the width
-                wxBORDER_SIMPLE)            // Draw a border around the view
+                wxBORDER_SIMPLE),           // Draw a border around the view
+        mFrame(parent), mPlayback(timeline), mTimer(this)
 {
     mImagesDir = imagesDir;
     mTimeline = timeline;
@@ -62,6 +67,7 @@ ViewTimeline::ViewTimeline(wxFrame* parent, std::wstring imagesDir, Timeline* ti
     Bind(wxEVT_LEFT_DOWN, &ViewTimeline::OnLeftDown, this);
     Bind(wxEVT_LEFT_UP, &ViewTimeline::OnLeftUp, this);
     Bind(wxEVT_MOTION, &ViewTimeline::OnMouseMove, this);
+    Bind(wxEVT_TIMER, &ViewTimeline::OnTimer, this);
 
     // Bind timeline edit events to the parent frame
     parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &ViewTimeline::OnEditSet, this, XRCID("EditSet"));
@@ -69,6 +75,67 @@ ViewTimeline::ViewTimeline(wxFrame* parent, std::wstring imagesDir, Timeline* ti
     parent->Bind(wxEVT_COMMAND_MENU_SELECTED,
             &ViewTimeline::OnEditTimelineProperties, this,
             XRCID("EditTimelineProperties"));
+    parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &ViewTimeline::OnEditInterpolation, this, XRCID("EditLinear"));
+    parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &ViewTimeline::OnEditInterpolation, this, XRCID("EditStep"));
+    parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &ViewTimeline::OnEditInterpolation, this, XRCID("EditSmooth"));
+    parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &ViewTimeline::OnEditInterpolation, this, XRCID("EditEase"));
+
+    // Bind playback events to the parent frame
+    parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &ViewTimeline::OnPlayPlay, this, XRCID("PlayPlay"));
+    parent->Bind(wxEVT_COMMAND_MENU_SELECTED, &ViewTimeline::OnPlayLoop, this, XRCID("PlayLoop"));
+}
+
+/**
+ * Handle the Play>Play/Pause menu event
+ * @param event Command event
+ */
+void ViewTimeline::OnPlayPlay(wxCommandEvent& event)
+{
+    if (mPlayback.IsPlaying())
+    {
+        mPlayback.Pause();
+        mTimer.Stop();
+    }
+    else
+    {
+        mPlayback.Play(Playback::Now());
+        GetPicture()->SetAnimationFrame(mPlayback.GetFrame());
+        mTimer.Start(PlaybackTimerInterval);
+    }
+}
+
+/**
+ * Handle the Play>Loop menu event
+ * @param event Command event
+ */
+void ViewTimeline::OnPlayLoop(wxCommandEvent& event)
+{
+    mPlayback.SetLoop(event.IsChecked());
+}
+
+/**
+ * Handle a playback timer event
+ *
+ * The frame shown comes from the clock, not from counting timer
+ * events, so slow repaints drop frames instead of slowing playback.
+ * @param event Timer event
+ */
+void ViewTimeline::OnTimer(wxTimerEvent& event)
+{
+    int frame = mPlayback.Update(Playback::Now());
+    if (frame != Playback::NoFrame)
+    {
+        GetPicture()->SetAnimationFrame(frame);
+
+        std::wstringstream str;
+        str << L"Dropped frames: " << mPlayback.GetDroppedFrames();
+        mFrame->SetStatusText(str.str());
+    }
+
+    if (!mPlayback.IsPlaying())
+    {
+        mTimer.Stop();
+    }
 }
 
 /**
@@ -90,7 +157,40 @@ void ViewTimeline::OnEditSet(wxCommandEvent& event)
  */
 void ViewTimeline::OnEditDelete(wxCommandEvent& event)
 {
+    int frame = mTimeline->GetCurrentFrame();
+    mTimeline->DeleteKeyframes(frame, frame);
+
+    // Update the actors for the keyframes that are left
+    GetPicture()->SetAnimationTime(mTimeline->GetCurrentTime());
+}
+
+/**
+ * Handle the Edit>Interpolation menu events
+ *
+ * Sets how the keyframes on the current frame move
+ * to the next keyframe.
+ * @param event Command event
+ */
+void ViewTimeline::OnEditInterpolation(wxCommandEvent& event)
+{
+    auto interpolation = AnimChannel::Interpolation::Linear;
+    if (event.GetId() == XRCID("EditStep"))
+    {
+        interpolation = AnimChannel::Interpolation::Step;
+    }
+    else if (event.GetId() == XRCID("EditSmooth"))
+    {
+        interpolation = AnimChannel::Interpolation::CatmullRom;
+    }
+    else if (event.GetId() == XRCID("EditEase"))
+    {
+        interpolation = AnimChannel::Interpolation::Ease;
+    }
+
+    int frame = mTimeline->GetCurrentFrame();
+    mTimeline->SetInterpolation(frame, frame, interpolation);
 
+    GetPicture()->SetAnimationTime(mTimeline->GetCurrentTime());
 }
 
 /**
@@ -178,6 +278,13 @@ void ViewTimeline::OnLeftDown(wxMouseEvent &event)
 
     mMovingPointer = x >= pointerX - mPointerImage->GetWidth() / 2 &&
             x <= pointerX + mPointerImage->GetWidth() / 2;
+
+    // Grabbing the pointer stops playback
+    if (mMovingPointer && mPlayback.IsPlaying())
+    {
+        mPlayback.Pause();
+        mTimer.Stop();
+    }
 }
 
 /**
@@ -9,6 +9,7 @@
 #define CANADIANEXPERIENCE_VIEWTIMELINE_H
 
 #include "PictureObserver.h"
+#include "Playback.h"
 
 class Timeline;
 
@@ -36,6 +37,15 @@ private:
     /// Flag to indicate we are moving the pointer
     bool mMovingPointer = false;
 
+    /// The frame we are on
+    wxFrame* mFrame;
+
+    /// Real-time playback clock
+    Playback mPlayback;
+
+    /// Timer that advances playback
+    wxTimer mTimer;
+
 
 
     void OnLeftDown(wxMouseEvent &event);
@@ -47,6 +57,11 @@ private:
     void OnEditSet(wxCommandEvent& event);
     void OnEditDelete(wxCommandEvent& event);
     void OnEditTimelineProperties(wxCommandEvent& event);
+    void OnEditInterpolation(wxCommandEvent& event);
+
+    void OnPlayPlay(wxCommandEvent& event);
+    void OnPlayLoop(wxCommandEvent& event);
+    void OnTimer(wxTimerEvent& event);
 
 public:
     static const int Height = 90;      ///< Height to make this window
@@ -0,0 +1,104 @@
+/**
+ * @file WxRenderer.cpp
+ * @author Noah Wolff
+ */
+
+#include "pch.h"
+#include "WxRenderer.h"
+#include "RenderImage.h"
+
+/**
+ * Constructor
+ * @param graphics The graphics context to draw on
+ */
+WxRenderer::WxRenderer(std::shared_ptr<wxGraphicsContext> graphics) : mGraphics(graphics)
+{
+}
+
+/**
+ * Save the graphics state and put a transformation on it
+ * @param transform Transformation to concatenate
+ */
+void WxRenderer::PushTransform(const Affine &transform)
+{
+    mGraphics->PushState();
+    mGraphics->ConcatTransform(mGraphics->CreateMatrix(transform.GetA(), transform.GetB(),
+            transform.GetC(), transform.GetD(),
+            transform.GetTranslation().m_x, transform.GetTranslation().m_y));
+}
+
+/**
+ * Make a path through points
+ * @param points Points on the path
+ * @param closed true to join the last point to the first
+ * @return The path
+ */
+wxGraphicsPath WxRenderer::MakePath(const std::vector<wxPoint2DDouble> &points, bool closed)
+{
+    auto path = mGraphics->CreatePath();
+    if (!points.empty())
+    {
+        path.MoveToPoint(points[0]);
+        for (size_t i = 1; i < points.size(); i++)
+        {
+            path.AddLineToPoint(points[i]);
+        }
+
+        if (closed)
+        {
+            path.CloseSubpath();
+        }
+    }
+
+    return path;
+}
+
+/**
+ * Draw an image
+ * @param image Image to draw, with its top left corner at (0, 0)
+ * @param transform Transformation from image pixels to the drawing
+ */
+void WxRenderer::DrawImage(const RenderImage &image, const Affine &transform)
+{
+    auto bitmap = mBitmaps.find(&image);
+    if (bitmap == mBitmaps.end())
+    {
+        bitmap = mBitmaps.emplace(&image, mGraphics->CreateBitmapFromImage(image.ToImage())).first;
+    }
+
+    PushTransform(transform);
+    mGraphics->DrawBitmap(bitmap->second, 0, 0, image.GetWidth(), image.GetHeight());
+    mGraphics->PopState();
+}
+
+/**
+ * Fill a polygon
+ * @param points Corners of the polygon, the last is joined to the first
+ * @param color Color to fill with
+ * @param transform Transformation from the points to the drawing
+ */
+void WxRenderer::FillPolygon(const std::vector<wxPoint2DDouble> &points, const wxColour &color,
+        const Affine &transform)
+{
+    PushTransform(transform);
+    mGraphics->SetBrush(wxBrush(color));
+    mGraphics->FillPath(MakePath(points, true));
+    mGraphics->PopState();
+}
+
+/**
+ * Draw a line through points
+ * @param points Points on the line
+ * @param closed true to join the last point to the first
+ * @param color Line color
+ * @param width Line width, in the same units as the points
+ * @param transform Transformation from the points to the drawing
+ */
+void WxRenderer::StrokePolyline(const std::vector<wxPoint2DDouble> &points, bool closed,
+        const wxColour &color, double width, const Affine &transform)
+{
+    PushTransform(transform);
+    mGraphics->SetPen(wxPen(color, (int)lround(width)));
+    mGraphics->StrokePath(MakePath(points, closed));
+    mGraphics->PopState();
+}
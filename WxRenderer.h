@@ -0,0 +1,61 @@
+/**
+ * @file WxRenderer.h
+ * @author Noah Wolff
+ *
+ * Renderer that draws on a wxGraphicsContext.
+ */
+
+#ifndef CANADIANEXPERIENCE_WXRENDERER_H
+#define CANADIANEXPERIENCE_WXRENDERER_H
+
+#include <map>
+#include "Renderer.h"
+
+
+/**
+ * Renderer that draws on a wxGraphicsContext.
+ *
+ * Images become graphics bitmaps the first time they are drawn
+ * and are kept for as long as the renderer is, so keep one
+ * renderer around rather than making one for every draw.
+ */
+class WxRenderer : public Renderer {
+private:
+    /// The graphics context we draw on
+    std::shared_ptr<wxGraphicsContext> mGraphics;
+
+    /// Graphics bitmaps for the images drawn so far
+    std::map<const RenderImage *, wxGraphicsBitmap> mBitmaps;
+
+    void PushTransform(const Affine &transform);
+
+    wxGraphicsPath MakePath(const std::vector<wxPoint2DDouble> &points, bool closed);
+
+public:
+    WxRenderer(std::shared_ptr<wxGraphicsContext> graphics);
+
+    /// Default constructor (disabled)
+    WxRenderer() = delete;
+
+    /// Copy constructor (disabled)
+    WxRenderer(const WxRenderer &) = delete;
+
+    /// Assignment operator
+    void operator=(const WxRenderer &) = delete;
+
+    void DrawImage(const RenderImage &image, const Affine &transform) override;
+
+    void FillPolygon(const std::vector<wxPoint2DDouble> &points, const wxColour &color,
+            const Affine &transform) override;
+
+    void StrokePolyline(const std::vector<wxPoint2DDouble> &points, bool closed,
+            const wxColour &color, double width, const Affine &transform) override;
+
+    /**
+     * Get the graphics context we draw on
+     * @return Graphics context
+     */
+    std::shared_ptr<wxGraphicsContext> GetGraphics() const { return mGraphics; }
+};
+
+#endif //CANADIANEXPERIENCE_WXRENDERER_H
@@ -0,0 +1,68 @@
+/**
+ * @file Y4mWriter.cpp
+ * @author Noah Wolff
+ */
+
+#include "pch.h"
+#include "Y4mWriter.h"
+#include "RenderImage.h"
+#include <sstream>
+
+/**
+ * Constructor
+ * @param out Stream to write to, opened in binary mode
+ */
+Y4mWriter::Y4mWriter(std::ostream &out) : VideoWriter(out)
+{
+}
+
+/**
+ * Start the video by writing the stream header
+ * @param width Width of the frames in pixels
+ * @param height Height of the frames in pixels
+ * @param frameRate Frames per second
+ * @param numFrames Number of frames that will be written
+ * @return true if the stream is good
+ */
+bool Y4mWriter::Begin(int width, int height, int frameRate, int numFrames)
+{
+    VideoWriter::Begin(width, height, frameRate, numFrames);
+    mPlanes.resize((size_t)width * height * 3);
+
+    std::ostringstream header;
+    header << "YUV4MPEG2 W" << width << " H" << height << " F" << frameRate << ":1 Ip A1:1 C444\n";
+    auto text = header.str();
+    Write(text.data(), text.size());
+    return GetStream().good();
+}
+
+/**
+ * Write the next frame
+ * @param image Frame, the size given to Begin
+ * @return true if the stream is still good
+ */
+bool Y4mWriter::WriteFrame(const RenderImage &image)
+{
+    size_t count = (size_t)image.GetWidth() * image.GetHeight();
+    mPlanes.resize(count * 3);
+    unsigned char *planeY = mPlanes.data();
+    unsigned char *planeU = planeY + count;
+    unsigned char *planeV = planeU + count;
+
+    // Premultiplied colors are the colors over black
+    const uint32_t *pixels = image.GetPixels();
+    for (size_t i = 0; i < count; i++)
+    {
+        int r = pixels[i] & 0xff;
+        int g = (pixels[i] >> 8) & 0xff;
+        int b = (pixels[i] >> 16) & 0xff;
+        planeY[i] = (unsigned char)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+        planeU[i] = (unsigned char)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+        planeV[i] = (unsigned char)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+    }
+
+    const char frameHeader[] = "FRAME\n";
+    Write(frameHeader, sizeof(frameHeader) - 1);
+    Write(mPlanes.data(), count * 3);
+    return GetStream().good();
+}
@@ -0,0 +1,36 @@
+/**
+ * @file Y4mWriter.h
+ * @author Noah Wolff
+ *
+ * Writes frames as an uncompressed YUV4MPEG2 video.
+ */
+
+#ifndef CANADIANEXPERIENCE_Y4MWRITER_H
+#define CANADIANEXPERIENCE_Y4MWRITER_H
+
+#include <vector>
+#include "VideoWriter.h"
+
+
+/**
+ * Writes frames as an uncompressed YUV4MPEG2 video.
+ *
+ * Y4M is what video encoders read most easily. The frames are
+ * 4:4:4 so no color is lost to subsampling, and converted with the
+ * BT.601 video range coefficients. Y4M has no alpha, so anything
+ * transparent comes out as if it were over black.
+ */
+class Y4mWriter : public VideoWriter {
+private:
+    /// The Y, U and V planes of a frame, reused for every frame
+    std::vector<unsigned char> mPlanes;
+
+public:
+    Y4mWriter(std::ostream &out);
+
+    bool Begin(int width, int height, int frameRate, int numFrames) override;
+
+    bool WriteFrame(const RenderImage &image) override;
+};
+
+#endif //CANADIANEXPERIENCE_Y4MWRITER_H